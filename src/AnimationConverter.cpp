@@ -0,0 +1,121 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      AnimationConverter.cpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "AnimationConverter.hpp"
+
+int main(int argc, char **argv) {
+
+	Log::logToStdTerm(true);
+	Log::setLogLevel(LOG_INFO);
+
+	vector<string> files;
+	int fps = 0;
+
+	for (int i = 1; i < argc; i++) {
+
+		string commandline(argv[i]);
+
+		// Help text.
+		if (commandline == "-h" or commandline == "--help") {
+			cout <<
+				"Animation converter command line usage:\n"
+				"animationConverter <options> input.xml output\n\n"
+				"Converts a FileReader rgba animation into the binary format (format=\"binary\").\n\n"
+				"options:\n"
+				"-v or --version          Display version information.\n"
+				"-h or --help             Display this help screen.\n"
+				"-f <fps> or --fps <fps>  Frames per second the animation was made for, stored for reference."
+				<< endl;
+			return EXIT_SUCCESS;
+		}
+
+		// Version Text.
+		if (commandline == "-v" or commandline == "--version") {
+			cout << endl << "Animation converter is part of " << LEDSpicer::LICENSE_BLOCK << endl;
+			return EXIT_SUCCESS;
+		}
+
+		// Frames per second.
+		if (commandline == "-f" or commandline == "--fps") {
+			try {
+				if (++i == argc)
+					throw Error("Missing frames per second");
+				fps = Utility::parseNumber(argv[i], "Invalid frames per second");
+				Utility::verifyValue<int>(fps, 0, UINT8_MAX);
+			}
+			catch (Error& e) {
+				LogError(e.getMessage());
+				return EXIT_FAILURE;
+			}
+			continue;
+		}
+
+		files.push_back(commandline);
+	}
+
+	if (files.size() != 2) {
+		LogError("Expected an input and an output file, try --help");
+		return EXIT_FAILURE;
+	}
+
+	try {
+		vector<vector<uint8_t>> frames(readRGBA(files[0]));
+		AnimationFile::write(files[1], frames, fps);
+		AnimationFile check(files[1]);
+		LogInfo(
+			"Wrote " + files[1] + " with " + to_string(check.getFrames()) + " frames of " +
+			to_string(check.getElements()) + " elements"
+		);
+	}
+	catch (Error& e) {
+		LogError(e.getMessage());
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+vector<vector<uint8_t>> readRGBA(const string& filename) {
+	XMLHelper file(filename, "");
+	tinyxml2::XMLElement* element = file.getRoot()->FirstChildElement(NODE_FRAME);
+	if (not element)
+		throw Error("No frames found for ") << filename;
+	vector<vector<uint8_t>> frames;
+	for (; element; element = element->NextSiblingElement(NODE_FRAME)) {
+		StringUMap frameData = file.processNode(element);
+		Utility::checkAttributes({PARAM_DEC}, frameData, NODE_FRAME);
+		vector<string> colorData = Utility::explode(frameData[PARAM_DEC], ',');
+		if (colorData.empty()) {
+			LogWarning("Empty Frame detected");
+			continue;
+		}
+		// An incomplete last color is completed with 0.
+		vector<uint8_t> frame(std::ceil(colorData.size() / 3.00) * AnimationFile::CHANNELS, 0);
+		for (size_t c = 0; c < colorData.size(); ++c) {
+			int color = Utility::parseNumber(colorData[c], "Invalid color value");
+			Utility::verifyValue<int>(color, 0, UINT8_MAX);
+			frame[c] = color;
+		}
+		frames.push_back(std::move(frame));
+	}
+	return frames;
+}
@@ -0,0 +1,40 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      AnimationConverter.hpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "utilities/XMLHelper.hpp"
+#include "utilities/AnimationFile.hpp"
+
+using namespace LEDSpicer::Utilities;
+
+#define NODE_FRAME "frm"
+#define PARAM_DEC  "dec"
+
+/**
+ * Reads the frames of a rgba animation.
+ * @param filename
+ * @return RGB for every element of every frame, empty frames are skipped.
+ * @throws Error if the file is not valid.
+ */
+vector<vector<uint8_t>> readRGBA(const string& filename);
+
+int main(int argc, char **argv);
@@ -55,8 +55,38 @@ void DataLoader::readConfiguration(
 	setInterval(1000 / (fps > MAXIMUM_FPS ? MAXIMUM_FPS : fps));
 	Actor::setFPS((fps > MAXIMUM_FPS ? MAXIMUM_FPS : fps));
 
-	// Set Port number.
-	portNumber = tempAttr[PARAM_PORT];
+	// Set the unix socket or the port number.
+	if (tempAttr.exists(PARAM_SOCKET)) {
+		socketPath = tempAttr[PARAM_SOCKET];
+		if (tempAttr.exists(PARAM_SOCKET_TYPE))
+			socketType = Socks::str2type(tempAttr[PARAM_SOCKET_TYPE]);
+		if (tempAttr.exists(PARAM_SOCKET_ALLOW)) {
+			for (auto& user : Utility::explode(tempAttr[PARAM_SOCKET_ALLOW], ',')) {
+				Utility::trim(user);
+				socketAllow.push_back(static_cast<uid_t>(Utility::parseNumber(user, invalidValueFor(PARAM_SOCKET_ALLOW))));
+			}
+		}
+	}
+	else if (tempAttr.exists(PARAM_PORT)) {
+		portNumber = tempAttr[PARAM_PORT];
+	}
+	else {
+		throw Utilities::Error("Missing " PARAM_PORT " or " PARAM_SOCKET " attribute");
+	}
+
+	// Set the messages handled per frame.
+	if (tempAttr.exists(PARAM_MESSAGE_BUDGET)) {
+		messageBudget = Utility::parseNumber(tempAttr[PARAM_MESSAGE_BUDGET], invalidValueFor(PARAM_MESSAGE_BUDGET));
+		if (not messageBudget) throw Utilities::Error(PARAM_MESSAGE_BUDGET " should be bigger than 0");
+	}
+
+	// Set the frame stream socket.
+	if (tempAttr.exists(PARAM_STREAM))
+		streamPath = tempAttr[PARAM_STREAM];
+
+	// Set the input wake up.
+	if (tempAttr.exists(PARAM_REACTIVE_INPUTS))
+		reactiveInputs = tempAttr[PARAM_REACTIVE_INPUTS] == "True";
 
 	// Read Colors.
 	processColorFile(PROJECT_DATA_DIR + createFilename(tempAttr[PARAM_COLORS]));
@@ -136,6 +166,13 @@ void DataLoader::processDevices() {
 		Utility::checkAttributes(REQUIRED_PARAM_DEVICE, deviceAttr, NODE_DEVICE);
 		auto device = createDevice(deviceAttr);
 		LogInfo("Processing " + device->getFullName());
+		if (deviceAttr.exists(PARAM_MAX_REFRESH)) {
+			int maxRefresh = Utility::parseNumber(deviceAttr[PARAM_MAX_REFRESH], invalidValueFor("maximum refresh"));
+			if (Utility::verifyValue<int>(maxRefresh, 1, Actor::getFPS() - 1, false))
+				device->setMaxRefresh(static_cast<uint8_t>(maxRefresh));
+			else
+				LogInfo(PARAM_MAX_REFRESH " ignored for " + device->getFullName() + ", the device will refresh every frame");
+		}
 		Device::devices.push_back(device);
 		processDeviceElements(xmlElement, device);
 	}
@@ -247,8 +284,17 @@ void DataLoader::processDeviceElements(tinyxml2::XMLElement* deviceNode, Device*
 			const string
 				rgbFormat(tempAttr.exists(PARAM_COLORFORMAT) ? tempAttr.at(PARAM_COLORFORMAT) : DEFAULT_ORDER),
 				groupName(name);
+			// A strip can span several devices, every shard continues the same group.
+			const bool span(size > 3 and tempAttr.exists(PARAM_SPAN) and tempAttr[PARAM_SPAN] == "True");
+			if (span and Group::layout.exists(groupName)) {
+				elem = Group::layout.at(groupName).size() + 1;
+				LogInfo("Strip " + groupName + " continues on " + device->getFullName() + " from element " + to_string(elem));
+			}
+			else if (size > 3 and Group::layout.exists(groupName)) {
+				throw Utilities::Error("Duplicated strip [" + groupName + "] in " + device->getFullName() + ", use " PARAM_SPAN " to extend a strip across devices");
+			}
 			// Create a group for the strip only.
-			if (size > 3)
+			else if (size > 3) {
 				Group::layout.emplace(
 					groupName,
 					Group{
@@ -256,6 +302,10 @@ void DataLoader::processDeviceElements(tinyxml2::XMLElement* deviceNode, Device*
 						defaultColor
 					}
 				);
+			}
+			// Shards are transferred concurrently.
+			if (span)
+				device->setConcurrentTransfer(true);
 			// Process element(s)
 			for (uint16_t c = pos; c < pos + size; ++elem) {
 				string elemName(name + (size > 3 ? to_string(elem) : ""));
@@ -584,6 +634,8 @@ vector<Actor*> DataLoader::processAnimation(const string& file, const string& ex
 		actorData = processNode(element);
 		Utility::checkAttributes(REQUIRED_PARAM_ACTOR, actorData, "actor for animation " + file);
 		actors.push_back(createAnimation(actorData));
+		if (actorData.exists("bake") and actorData["bake"] == "True")
+			actors.back()->bake();
 	}
 
 	return actors;
@@ -624,6 +676,9 @@ Actor* DataLoader::createAnimation(StringUMap& actorData) {
 
 	if (actorName == "Serpentine")
 		return new Serpentine(actorData, &Group::layout.at(groupName));
+
+	if (actorName == "Shader")
+		return new Shader(actorData,     &Group::layout.at(groupName));
 	throw Utilities::Error(actorName) << " is not a valid animation";
 }
 
@@ -647,7 +702,7 @@ void DataLoader::processInput(Profile* profile, const string& file) {
 			StringUMap mapsNodeAttr = processNode(mapsNode);
 			Utility::checkAttributes({"source"}, mapsNodeAttr, inputName);
 			listenEvents.push_back(mapsNodeAttr["source"]);
-			processInputMap(mapsNode, inputMapTmp, to_string(c));
+			processInputMap(mapsNode, inputMapTmp, to_string(c) + TRIGGER_SEPARATOR);
 		}
 		else {
 			processInputMap(mapsNode, inputMapTmp);
@@ -667,7 +722,7 @@ Device* DataLoader::createDevice(StringUMap& deviceData) {
 
 	string deviceName = deviceData["name"];
 	if (not DeviceHandler::deviceHandlers.exists(deviceName))
-		DeviceHandler::deviceHandlers.emplace(deviceName, new DeviceHandler(deviceName));
+		DeviceHandler::deviceHandlers.emplace(deviceName, DeviceHandler::loadHandler(deviceName));
 	return DeviceHandler::deviceHandlers[deviceName]->createDevice(deviceData);
 }
 
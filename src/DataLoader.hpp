@@ -35,6 +35,7 @@
 #endif
 #include "animations/Random.hpp"
 #include "animations/Serpentine.hpp"
+#include "animations/Shader.hpp"
 
 #include "inputs/Actions.hpp"
 #include "inputs/Credits.hpp"
@@ -56,12 +57,19 @@
 #define PROFILE_DIR  "profiles/"
 #define INPUT_DIR    "inputs/"
 #define MAXIMUM_FPS  60
+#define DEFAULT_MESSAGE_BUDGET 32
 
 #define PARAM_FPS             "fps"
 #define PARAM_COLORS          "colors"
 #define PARAM_COLOR           "color"
 #define PARAM_RANDOM_COLORS   "randomColors"
 #define PARAM_PORT            "port"
+#define PARAM_SOCKET          "socket"
+#define PARAM_SOCKET_TYPE     "socketType"
+#define PARAM_SOCKET_ALLOW    "socketAllow"
+#define PARAM_MESSAGE_BUDGET  "messageBudget"
+#define PARAM_STREAM          "stream"
+#define PARAM_REACTIVE_INPUTS "reactiveInputs"
 #define PARAM_LOG_LEVEL       "logLevel"
 #define PARAM_NAME            "name"
 #define PARAM_DEFAULT_COLOR   "defaultColor"
@@ -81,6 +89,8 @@
 #define PARAM_GROUP_ID        "groupId"
 #define PARAM_FILTER          "filter"
 #define PARAM_BRIGHTNESS      "brightness"
+#define PARAM_MAX_REFRESH     "maxRefresh"
+#define PARAM_SPAN            "span"
 
 #define NODE_DEVICES           "devices"
 #define NODE_DEVICE            "device"
@@ -95,7 +105,7 @@
 #define NODE_ACTOR             "actor"
 #define NODE_TRANSITION        "transition"
 
-#define REQUIRED_PARAM_ROOT           {"colors", "fps", "port", "userId", "groupId"}
+#define REQUIRED_PARAM_ROOT           {"colors", "fps", "userId", "groupId"}
 #define REQUIRED_PARAM_COLOR          {"name", "color"}
 #define REQUIRED_PARAM_DEVICE         {"name"}
 #define REQUIRED_PARAM_DEVICE_ELEMENT {"name", "type"}
@@ -261,6 +271,24 @@ public:
 	/// Port number to use for listening.
 	inline static string portNumber {};
 
+	/// Unix socket file to use for listening, takes precedence over the port.
+	inline static string socketPath {};
+
+	/// Unix socket type, SOCK_DGRAM or SOCK_SEQPACKET.
+	inline static int socketType = SOCK_DGRAM;
+
+	/// Users allowed to send messages over the unix socket, empty for everyone.
+	inline static vector<uid_t> socketAllow {};
+
+	/// Maximum number of messages handled per frame.
+	inline static uint16_t messageBudget = DEFAULT_MESSAGE_BUDGET;
+
+	/// Unix socket file used to stream the frames, empty to disable.
+	inline static string streamPath {};
+
+	/// If true, an input event starts the next frame without waiting the full interval.
+	inline static bool reactiveInputs = false;
+
 	/// Keeps the milliseconds to wait.
 	inline static milliseconds waitTime {};
 
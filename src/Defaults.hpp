@@ -125,6 +125,7 @@ constexpr char RECORD_SEPARATOR   = 31;  // Unit Separator (US)
 constexpr char FIRST_CHARACTER    = 32;  // Space
 constexpr char ID_SEPARATOR       = ','; // Comma
 constexpr char ID_GROUP_SEPARATOR = '|'; // Pipe
+constexpr char TRIGGER_SEPARATOR  = ':'; // Colon
 
 /**
  * Flags
@@ -152,6 +153,16 @@ constexpr char ID_GROUP_SEPARATOR = '|'; // Pipe
 constexpr char LOCALHOST[]   = "127.0.0.1";
 /// Number of bytes to read/write in a single operation.
 constexpr size_t BUFFER_SIZE = 256;
+/// Largest datagram accepted on a batch read.
+constexpr size_t DATAGRAM_SIZE = 65536;
+/// Number of datagrams read by a single system call.
+constexpr size_t RECEIVE_BATCH = 32;
+/// Maximum number of clients connected to a unix SOCK_SEQPACKET server.
+constexpr size_t SOCKET_CLIENTS = 32;
+/// Maximum number of frame stream subscribers.
+constexpr size_t STREAM_SUBSCRIBERS = 8;
+/// A frame stream subscriber gets a keyframe at least every this number of frames.
+constexpr uint16_t STREAM_KEYFRAME_INTERVAL = 300;
 /// Ports to scan: ignoring old or unrelated like /dev/ttyS
 constexpr array<const char*, 2> DEFAULT_SERIAL_PORTS{"ttyUSB", "ttyACM"};
 /// Maximum number of serial ports to scan (ttyUSB1..ttyUSB5, ttyACM1..ttyACM5)
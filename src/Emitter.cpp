@@ -22,24 +22,23 @@
 
 #include "Emitter.hpp"
 
-using pclose_type = int (*)(FILE*);
-
 int main(int argc, char **argv) {
 
 	string
 		commandline,
 		configFile = "",
+		romList,
 		port,
+		socketPath,
 		flagsStr;
 
-	Message msg;
+	int socketType = SOCK_DGRAM;
 
-	vector<string> dataSource;
+	Message msg;
 
 	bool
-		craftProfile = false,
-		rotate       = true,
-		useColors    = false;
+		binary     = false,
+		buildIndex = false;
 
 	uint8_t flags = 0;
 
@@ -73,12 +72,19 @@ int main(int argc, char **argv) {
 				" groupName                        Removes a group's background color.\n" <<
 				Message::type2str(Message::Types::ClearAllGroups) <<
 				"                              Removes all groups' background color.\n" <<
+				Message::type2str(Message::Types::Batch) <<
+				" file                                  Sends the Set and Clear commands from a file (one per line, - or empty for stdin) applied together.\n" <<
 				"options:\n"
 				"-v or --version               Display version information.\n"
 				"-h or --help                  Display this help screen.\n"
 				"-c <conf> or --config <conf>  Use an alternative configuration file.\n"
 				"-n or --no-rotate             Will raise NO_ROTATOR flag\n"
 				"-r or --replace               Same as REPLACE flag.\n"
+				"-b or --binary                Send the message using the binary protocol.\n"
+				"--prewarm-mame <file>         Caches the MAME data for the ROMs listed in a file (one per line, - for stdin).\n"
+				"--build-index                 Compiles the game data files into " INDEX_FILE " for faster lookups.\n"
+				"-d or --daemon                Stay resident with the configuration loaded, translating the requests received on\n"
+				"                              " PARAM_EMITTER_SOCKET " and sending them to ledspicerd.\n"
 				"-f <flags> or --flags <flags> Send extra flags to LEDSPicer, pipe separated surrounded by quotes.\n"
 				"  Available Flags:\n"
 				"  * NO_ANIMATIONS  The animations of the profile will be ignored.\n"
@@ -123,6 +129,36 @@ int main(int argc, char **argv) {
 			continue;
 		}
 
+		// Binary protocol.
+		if (commandline == "-b" or commandline == "--binary") {
+			binary = true;
+			continue;
+		}
+
+		// Resident mode.
+		if (commandline == "-d" or commandline == "--daemon") {
+			resident = true;
+			continue;
+		}
+
+		// Game data index.
+		if (commandline == "--build-index") {
+			buildIndex = true;
+			continue;
+		}
+
+		// MAME cache.
+		if (commandline == "--prewarm-mame") {
+			try {
+				romList = getNext(++i, argc, argv);
+			}
+			catch (Error& e) {
+				LogError(e.getMessage());
+				return EXIT_FAILURE;
+			}
+			continue;
+		}
+
 		// Flags.
 		if (commandline == "-f" or commandline == "--flags") {
 			try {
@@ -152,12 +188,37 @@ int main(int argc, char **argv) {
 
 	// Convert flag string into flags.
 	Message::str2flag(flags, flagsStr);
-	if (flags & FLAG_NO_ROTATOR) {
-		rotate = false;
-	}
 	msg.setFlags(flags);
 
-	if (msg.getType() == Message::Types::Invalid) {
+	if (buildIndex) {
+		Log::initialize(true);
+		try {
+			size_t games = GameIndex::build(INDEX_FILE);
+			LogInfo("Indexed " + to_string(games) + " games into " INDEX_FILE);
+			cout << "Indexed " << games << " games into " INDEX_FILE << endl;
+		}
+		catch (Error& e) {
+			LogError("Error: " + e.getMessage());
+			return EXIT_FAILURE;
+		}
+		return EXIT_SUCCESS;
+	}
+
+	if (not romList.empty()) {
+		Log::initialize(true);
+		try {
+			mameCache.open(MameCache::getDefaultPath());
+			size_t games = prewarmMameCache(romList);
+			cout << "Cached " << games << " games" << endl;
+		}
+		catch (Error& e) {
+			LogError("Error: " + e.getMessage());
+			return EXIT_FAILURE;
+		}
+		return EXIT_SUCCESS;
+	}
+
+	if (msg.getType() == Message::Types::Invalid and not resident) {
 		LogError("Nothing to do");
 		return EXIT_SUCCESS;
 	}
@@ -176,112 +237,89 @@ int main(int argc, char **argv) {
 		if (configValues.exists("logLevel"))
 			Log::setLogLevel(Log::str2level(configValues["logLevel"]));
 
+		EmitterSettings settings;
+		settings.configFile = configFile;
+
 		// Set craft profile mode.
 		if (configValues.exists("craftProfile"))
-			craftProfile = configValues["craftProfile"] == "True";
+			settings.craftProfile = configValues["craftProfile"] == "True";
 
 		// Set use colors file.
 		if (configValues.exists("colorsFile")) {
 			ignoreMissingColors = configValues["colorsFile"] == "Strict";
-			useColors = ignoreMissingColors or configValues["colorsFile"] == "True";
+			settings.useColors = ignoreMissingColors or configValues["colorsFile"] == "True";
 			LogDebug(ignoreMissingColors ? "ignoreMissingColors ON" : "ignoreMissingColors OFF");
 		}
 
-		// Port.
-		if (configValues.exists("port"))
+		// Unix socket or port.
+		if (configValues.exists("socket")) {
+			socketPath = configValues["socket"];
+			if (configValues.exists("socketType"))
+				socketType = Socks::str2type(configValues["socketType"]);
+		}
+		else if (configValues.exists("port")) {
 			port = configValues["port"];
-		else
-			throw Error("Missing port attribute");
+		}
+		else {
+			throw Error("Missing port or socket attribute");
+		}
 
 		// Check restrictors.
-		if (rotate) {
-			tinyxml2::XMLElement* xmlElement = config.getRoot()->FirstChildElement("restrictors");
-			rotate = (xmlElement and xmlElement->FirstChildElement("restrictor"));
-		}
+		tinyxml2::XMLElement* xmlElement = config.getRoot()->FirstChildElement("restrictors");
+		settings.rotate = (xmlElement and xmlElement->FirstChildElement("restrictor"));
 
-		// Check request
-		vector<string> data = msg.getData();
-		if (msg.getType() == Message::Types::LoadProfileByEmulator) {
-			// parameter 1 is ROM, parameter 2 is system.
-			if (data.size() < 2) {
-				LogError("Error: Invalid request");
-				return EXIT_FAILURE;
-			}
-			// Check for path and extension and clean.
-			data[0] = Utility::explode(Utility::explode(data[0], '/').back(), '.')[0];
-			msg.reset();
-			msg.setType(Message::Types::LoadProfile);
-			msg.addData(string(data[1]).append("/").append(data[0]));
-			// Arcades (mame and others).
-			if (data[1] == ARCADE_SYSTEM) {
-
-				// Set data source, default to file.
-				if (configValues.exists(PARAM_DATA_SOURCE))
-					dataSource = Utility::explode(configValues[PARAM_DATA_SOURCE], ',');
-				else
-					dataSource = {DATA_SOURCE_FILE};
-
-				GameRecord gd;
-				for (string& ds : dataSource) {
-					Utility::trim(ds);
-					try {
-						if (ds == DATA_SOURCE_MAME) {
-							gd = parseMame(data[0]);
-							break;
-						}
-						if (ds == DATA_SOURCE_FILE) {
-							gd = parseMameDataFile(data[0]);
-							break;
-						}
-						if (ds == DATA_SOURCE_CONTROLSINI) {
-							gd = parseControlsIni(data[0]);
-							break;
-						}
-					}
-					catch (Error& e) {
-						LogDebug("Error: " + e.getMessage());
-						continue;
-					}
-					if (gd.players == "0") continue;
-					LogDebug("got " + gd.players + " players data from " + ds);
-				}
-				if (gd.players == "0") {
-					LogNotice("No player data detected");
+		// Set data source, default to file.
+		if (configValues.exists(PARAM_DATA_SOURCE))
+			settings.dataSource = Utility::explode(configValues[PARAM_DATA_SOURCE], ',');
+		else
+			settings.dataSource = {DATA_SOURCE_FILE};
+		for (string& ds : settings.dataSource)
+			Utility::trim(ds);
+
+		// Use the game data index when up to date.
+		gameIndex.open(INDEX_FILE);
+
+		// Load the MAME cache when used.
+		if (std::find(settings.dataSource.begin(), settings.dataSource.end(), DATA_SOURCE_MAME) != settings.dataSource.end())
+			mameCache.open(MameCache::getDefaultPath());
+
+		// Open connection.
+		Client client(port, socketPath, socketType);
+
+		if (resident) {
+			// Only the unix socket, it checks the sender like ledspicerd does.
+			if (not configValues.exists(PARAM_EMITTER_SOCKET))
+				throw Error("Missing " PARAM_EMITTER_SOCKET " attribute");
+			vector<uid_t> allowedUsers;
+			if (configValues.exists(PARAM_SOCKET_ALLOW)) {
+				for (auto& user : Utility::explode(configValues[PARAM_SOCKET_ALLOW], ',')) {
+					Utility::trim(user);
+					allowedUsers.push_back(static_cast<uid_t>(Utility::parseNumber(user, "Invalid value for " PARAM_SOCKET_ALLOW)));
 				}
-				else {
-					if (useColors)
-						decorateWithColorsIni(data[0], gd);
-
-					// Craft Profile mode
-					if (craftProfile) {
-						msg.setType(Message::Types::CraftProfile);
-						for (string& s : gd.toString())
-							msg.addData(s);
-					}
-					// Legacy profile mode.
-					else {
-						// Create a message that sends player + buttons information.
-						msg.addData("P" + gd.players + "_B" + gd.playersData.begin()->second.buttons);
-						// Create a message that sends controller + buttons information.
-						msg.addData(gd.playersData.begin()->second.controllers.front() + gd.players + "_B" + gd.playersData.begin()->second.buttons);
-					}
+			}
+			Messages requests("", configValues[PARAM_EMITTER_SOCKET], SOCK_DGRAM, allowedUsers);
+			runResident(requests, client, settings, binary);
+			return EXIT_SUCCESS;
+		}
 
-					// Rotate restrictors.
-					if (rotate) {
-						string parameters(configFile != CONFIG_FILE ? "-c \"" + configFile + "\"" : "");
-						gd.rotate(parameters);
-					}
-					else {
-						LogDebug("Restrictors ignored or not found");
-					}
-				}
+		if (msg.getType() == Message::Types::Batch) {
+			vector<string> data = msg.getData();
+			msg.reset();
+			msg.setType(Message::Types::Batch);
+			msg.setFlags(flags);
+			readBatch(data.empty() ? "-" : data[0], msg);
+			if (msg.getData().empty()) {
+				LogError("Error: Empty batch");
+				return EXIT_FAILURE;
 			}
-			msg.addData(data[1]);
+		}
+		else if (not translate(msg, settings)) {
+			LogError("Error: Invalid request");
+			return EXIT_FAILURE;
 		}
 
-		// Open connection and send message.
-		Socks sock(LOCALHOST, port);
-		bool r = sock.send(msg.toString());
+		// Send message.
+		bool r = client.send(msg, binary);
 		LogDebug("Message " + string(r ? "sent successfully" : "failed to send") + " Task: " + Message::type2str(msg.getType()) + "\nData: " + msg.toHumanString() + "\nFlags: " + Message::flag2str(msg.getFlags()));
 	}
 	catch(Error& e) {
@@ -292,27 +330,220 @@ int main(int argc, char **argv) {
 	return EXIT_SUCCESS;
 }
 
+bool translate(Message& msg, const EmitterSettings& settings) {
+
+	if (msg.getType() != Message::Types::LoadProfileByEmulator)
+		return true;
+
+	// parameter 1 is ROM, parameter 2 is system.
+	vector<string> data = msg.getData();
+	if (data.size() < 2)
+		return false;
+
+	uint8_t flags = msg.getFlags();
+	bool rotate   = settings.rotate and not (flags & FLAG_NO_ROTATOR);
+
+	// Check for path and extension and clean.
+	data[0] = Utility::explode(Utility::explode(data[0], '/').back(), '.')[0];
+	if (not isValidName(data[0]) or not isValidName(data[1]))
+		return false;
+	msg.reset();
+	msg.setType(Message::Types::LoadProfile);
+	msg.setFlags(flags);
+	msg.addData(string(data[1]).append("/").append(data[0]));
+	// Arcades (mame and others).
+	if (data[1] == ARCADE_SYSTEM) {
+
+		GameRecord gd;
+		for (const string& ds : settings.dataSource) {
+			try {
+				if (ds == DATA_SOURCE_MAME) {
+					if (not mameCache.find(data[0], gd)) {
+						gd = parseMame(data[0]);
+						mameCache.store(data[0], gd);
+					}
+					break;
+				}
+				if (ds == DATA_SOURCE_FILE) {
+					if (not gameIndex.isOpen())
+						gd = parseMameDataFile(data[0]);
+					else if (not gameIndex.find(data[0], GameIndex::File, gd))
+						throw Error("Game ") << data[0] << " no player data found";
+					break;
+				}
+				if (ds == DATA_SOURCE_CONTROLSINI) {
+					if (not gameIndex.isOpen())
+						gd = parseControlsIni(data[0]);
+					else if (not gameIndex.find(data[0], GameIndex::ControlsIni, gd))
+						throw Error("Game ") << data[0] << " no player data found";
+					break;
+				}
+			}
+			catch (Error& e) {
+				LogDebug("Error: " + e.getMessage());
+				continue;
+			}
+			if (gd.players == "0") continue;
+			LogDebug("got " + gd.players + " players data from " + ds);
+		}
+		if (gd.players == "0") {
+			LogNotice("No player data detected");
+		}
+		else {
+			if (settings.useColors) {
+				GameRecord colors;
+				if (not gameIndex.isOpen())
+					decorateWithColorsIni(data[0], gd);
+				else if (gameIndex.find(data[0], GameIndex::ColorsIni, colors))
+					decorateWithColors(colors, gd);
+			}
+
+			// Craft Profile mode
+			if (settings.craftProfile) {
+				msg.setType(Message::Types::CraftProfile);
+				for (string& s : gd.toString())
+					msg.addData(s);
+			}
+			// Legacy profile mode.
+			else {
+				// Create a message that sends player + buttons information.
+				msg.addData("P" + gd.players + "_B" + gd.playersData.begin()->second.buttons);
+				// Create a message that sends controller + buttons information.
+				msg.addData(gd.playersData.begin()->second.controllers.front() + gd.players + "_B" + gd.playersData.begin()->second.buttons);
+			}
+
+			// Rotate restrictors.
+			if (rotate) {
+				string parameters(settings.configFile != CONFIG_FILE ? "-c \"" + settings.configFile + "\"" : "");
+				gd.rotate(parameters);
+			}
+			else {
+				LogDebug("Restrictors ignored or not found");
+			}
+		}
+	}
+	msg.addData(data[1]);
+	return true;
+}
+
+bool isValidName(const string& name) {
+	if (name.empty())
+		return false;
+	for (char c : name)
+		if (not std::isalnum(static_cast<unsigned char>(c)) and c != '_' and c != '-')
+			return false;
+	return true;
+}
+
+string runCommand(const vector<string>& arguments) {
+
+	LogDebug("Running: " + Utility::implode(arguments, ' '));
+
+	vector<char*> argv;
+	for (auto& argument : arguments)
+		argv.push_back(const_cast<char*>(argument.c_str()));
+	argv.push_back(nullptr);
+
+	int fds[2];
+	if (pipe(fds))
+		throw Error("Failed to run ") << arguments.front();
+
+	posix_spawn_file_actions_t actions;
+	posix_spawn_file_actions_init(&actions);
+	posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+	posix_spawn_file_actions_addclose(&actions, fds[0]);
+	posix_spawn_file_actions_addclose(&actions, fds[1]);
+	pid_t pid;
+	int error = posix_spawnp(&pid, argv[0], &actions, nullptr, argv.data(), environ);
+	posix_spawn_file_actions_destroy(&actions);
+	close(fds[1]);
+	if (error) {
+		close(fds[0]);
+		throw Error("Failed to run ") << arguments.front();
+	}
+
+	string output;
+	std::array<char, 4096> buffer;
+	ssize_t r;
+	while ((r = read(fds[0], buffer.data(), buffer.size())) > 0 or (r == -1 and errno == EINTR))
+		if (r > 0)
+			output.append(buffer.data(), r);
+	close(fds[0]);
+	int status;
+	while (waitpid(pid, &status, 0) == -1 and errno == EINTR);
+	return output;
+}
+
+void runResident(Messages& requests, Client& client, const EmitterSettings& settings, bool binary) {
+
+	signal(SIGTERM, stopResident);
+	signal(SIGINT,  stopResident);
+	signal(SIGQUIT, stopResident);
+
+	LogInfo("Emitter resident");
+	while (resident) {
+		if (not requests.wait(RESIDENT_WAIT) or not requests.read())
+			continue;
+		while (requests.hasMessages()) {
+			Message msg(requests.getMessage());
+			if (not translate(msg, settings)) {
+				LogNotice("Invalid request for " + Message::type2str(msg.getType()));
+				continue;
+			}
+			try {
+				bool r = client.send(msg, binary);
+				LogDebug("Message " + string(r ? "sent successfully" : "failed to send") + " Task: " + Message::type2str(msg.getType()) + "\nData: " + msg.toHumanString() + "\nFlags: " + Message::flag2str(msg.getFlags()));
+			}
+			catch (Error& e) {
+				LogNotice("Error: " + e.getMessage());
+			}
+		}
+	}
+	LogInfo("Emitter terminated");
+}
+
+void stopResident(int) {
+	resident = false;
+}
+
 string getNext(int index, int total, char **argv) {
 	if (index == total)
 		throw Error("Invalid number of parameters");
 	return argv[index];
 }
 
-GameRecord parseMameDataFile(const string& rom) {
+void readBatch(const string& source, Message& msg) {
 
-	string
-		output,
-		cmd = "grep -w '" + rom + "' " + CONTROLLERS_FILE;
-	LogDebug("running: " + cmd);
+	std::ifstream file;
+	if (source != "-") {
+		file.open(source);
+		if (not file.is_open())
+			throw Error("Unable to open batch file ") << source;
+	}
+	std::istream& input(source == "-" ? std::cin : file);
 
-	std::unique_ptr<FILE, pclose_type> pipe(popen(cmd.c_str(), "r"), pclose);
-	if (not pipe)
-		throw Error("Failed to read games data file");
+	string line;
+	while (std::getline(input, line)) {
+		Utility::trim(line);
+		if (line.empty() or line[0] == '#')
+			continue;
+		Message operation;
+		for (auto& part : Utility::explode(line, ' ')) {
+			Utility::trim(part);
+			if (part.empty())
+				continue;
+			if (operation.getType() == Message::Types::Invalid)
+				operation.setType(Message::str2type(part));
+			else
+				operation.addData(part);
+		}
+		msg.addOperation(operation);
+	}
+}
 
-	std::array<char, 128> buffer;
-	while (fgets(buffer.data(), buffer.size(), pipe.get()) != nullptr)
-		output += buffer.data();
+GameRecord parseMameDataFile(const string& rom) {
 
+	string output(runCommand({"grep", "-w", "--", rom, CONTROLLERS_FILE}));
 	if (not output.size())
 		throw Error("Game ") << rom << " no player data found";
 
@@ -331,19 +562,7 @@ GameRecord parseMameDataFile(const string& rom) {
 
 GameRecord parseMame(const string& rom) {
 
-	string
-		output,
-		cmd = "mame -lx '" + rom + "'";
-	LogDebug("running: " + cmd);
-
-	std::unique_ptr<FILE, pclose_type> pipe(popen(cmd.c_str(), "r"), pclose);
-	if (not pipe)
-		throw Error("Failed to gather MAME data");
-
-	std::array<char, 128> buffer;
-	while (fgets(buffer.data(), buffer.size(), pipe.get()) != nullptr)
-		output += buffer.data();
-
+	string output(runCommand({"mame", "-lx", rom}));
 	if (not output.size())
 		throw Error("Game ") << rom << " no player data found";
 
@@ -359,28 +578,18 @@ GameRecord parseMame(const string& rom) {
 }
 
 GameRecord parseControlsIni(const string& rom) {
+	return parseControlsIniSection(rom, readIniSection(CONTROLINI_FILE, rom));
+}
 
-	string cmd = "sed -n '/" + rom + "/,/\\[/p' " CONTROLINI_FILE;
-
-	LogDebug("Running: " + cmd);
-
-	std::unique_ptr<FILE, pclose_type> pipe(popen(cmd.c_str(), "r"), pclose);
-	if (not pipe)
-		throw Error("Failed to gather MAME data");
+vector<string> readIniSection(const string& file, const string& rom) {
 
-	GameRecord tempData;
-	std::array<char, 128> buffer;
-	bool
-		found  = false,
-		alter  = false,
-		mirror = false;
-
-	vector<string> buttons;
-	vector<string> controls;
+	std::istringstream output(runCommand({"sed", "-n", "/" + rom + "/,/\\[/p", file}));
 
-	while (fgets(buffer.data(), buffer.size(), pipe.get()) != nullptr) {
+	vector<string> lines;
+	string tmp;
+	bool found = false;
 
-		string tmp = buffer.data();
+	while (std::getline(output, tmp)) {
 
 		if (not found and tmp.find("[" + rom + "]") != string::npos) {
 			found = true;
@@ -390,7 +599,26 @@ GameRecord parseControlsIni(const string& rom) {
 		if (not found)
 			continue;
 
+		if (tmp.find("[") != string::npos)
+			break;
+
 		Utility::trim(tmp);
+		lines.push_back(tmp);
+	}
+	return lines;
+}
+
+GameRecord parseControlsIniSection(const string& rom, const vector<string>& lines) {
+
+	GameRecord tempData;
+	bool
+		alter  = false,
+		mirror = false;
+
+	vector<string> buttons;
+	vector<string> controls;
+
+	for (const string& tmp : lines) {
 
 		if (tmp.empty())
 			break;
@@ -513,33 +741,15 @@ GameRecord parseMameData(const string& rom, tinyxml2::XMLElement* inputNode, boo
 }
 
 void decorateWithColorsIni(const string& rom, GameRecord& gr) {
+	LogDebug("Reading color profile for " + rom);
+	decorateWithColors(parseColorsIniSection(readIniSection(COLORINI_FILE, rom)), gr);
+}
 
-	string cmd = "sed -n '/" + rom + "/,/\\[/p' " COLORINI_FILE;
-
-	LogDebug("Reading color profile: " + cmd);
-
-	std::unique_ptr<FILE, pclose_type> pipe(popen(cmd.c_str(), "r"), pclose);
-	if (not pipe)
-		throw Error("Failed to gather color data");
-
-	std::array<char, 128> buffer;
-	bool found  = false;
+GameRecord parseColorsIniSection(const vector<string>& lines) {
 
-	while (fgets(buffer.data(), buffer.size(), pipe.get()) != nullptr) {
+	GameRecord colors;
 
-		string tmp = buffer.data();
-		if (not found and tmp.find("[" + rom + "]") != string::npos) {
-			found = true;
-			continue;
-		}
-
-		if (not found)
-			continue;
-
-		else if (tmp.find("[") != string::npos)
-			break;
-
-		Utility::trim(tmp);
+	for (const string& tmp : lines) {
 
 		auto parts = Utility::explode(tmp, '=');
 		if (parts.size() != 2)
@@ -551,7 +761,7 @@ void decorateWithColorsIni(const string& rom, GameRecord& gr) {
 
 		string player = string() + pair[0].back();
 
-		PlayerData& pd = gr.playersData[player];
+		PlayerData& pd = colors.playersData[player];
 		if (pd.player.empty())
 			pd.player = player;
 		/*
@@ -577,6 +787,19 @@ void decorateWithColorsIni(const string& rom, GameRecord& gr) {
 		pd.buttonColors.emplace(parts[0], parts[1]);
 		continue;
 	}
+	return colors;
+}
+
+void decorateWithColors(const GameRecord& colors, GameRecord& gr) {
+	for (auto& p : colors.playersData) {
+		PlayerData& pd = gr.playersData[p.first];
+		if (pd.player.empty())
+			pd.player = p.first;
+		for (auto& c : p.second.controlColors)
+			pd.controlColors.emplace(c.first, c.second);
+		for (auto& c : p.second.buttonColors)
+			pd.buttonColors.emplace(c.first, c.second);
+	}
 }
 
 string mameController2ledspicer(const string& controller) {
@@ -760,3 +983,411 @@ string PlayerData::rotate() {
 		command += player + " " + to_string(c + 1) + " '" + ways[c] + "' ";
 	return command;
 }
+
+/* Game data index */
+
+/**
+ * Appends a length prefixed string.
+ * @param[out] output
+ * @param value
+ */
+static void writeString(string& output, const string& value) {
+	uint16_t length = value.size();
+	output.append(reinterpret_cast<const char*>(&length), sizeof(length));
+	output.append(value);
+}
+
+/**
+ * Reads a length prefixed string.
+ * @param[in,out] data moved after the string.
+ * @param end
+ * @return the string.
+ */
+static string readString(const char*& data, const char* end) {
+	uint16_t length;
+	if (end - data < static_cast<ptrdiff_t>(sizeof(length)))
+		throw Error("Corrupted game data index");
+	memcpy(&length, data, sizeof(length));
+	data += sizeof(length);
+	if (end - data < length)
+		throw Error("Corrupted game data index");
+	string value(data, length);
+	data += length;
+	return value;
+}
+
+void GameRecord::serialize(string& output) const {
+	writeString(output, players);
+	writeString(output, coins);
+	writeString(output, to_string(playersData.size()));
+	for (auto& p : playersData) {
+		const PlayerData& pd = p.second;
+		writeString(output, p.first);
+		writeString(output, pd.player);
+		writeString(output, pd.buttons);
+		writeString(output, Utility::implode(pd.controllers, FIELD_SEPARATOR));
+		writeString(output, Utility::implode(pd.ways, FIELD_SEPARATOR));
+		for (auto colors : {&pd.controlColors, &pd.buttonColors}) {
+			writeString(output, to_string(colors->size()));
+			for (auto& c : *colors) {
+				writeString(output, c.first);
+				writeString(output, c.second);
+			}
+		}
+	}
+}
+
+GameRecord GameRecord::deserialize(const char* data, size_t size) {
+	const char* end = data + size;
+	GameRecord record;
+	record.players = readString(data, end);
+	record.coins   = readString(data, end);
+	for (int p = Utility::parseNumber(readString(data, end), "Corrupted game data index"); p > 0; --p) {
+		PlayerData& pd = record.playersData[readString(data, end)];
+		pd.player  = readString(data, end);
+		pd.buttons = readString(data, end);
+		string list(readString(data, end));
+		if (not list.empty())
+			pd.controllers = Utility::explode(list, FIELD_SEPARATOR);
+		list = readString(data, end);
+		if (not list.empty())
+			pd.ways = Utility::explode(list, FIELD_SEPARATOR);
+		for (auto colors : {&pd.controlColors, &pd.buttonColors}) {
+			for (int c = Utility::parseNumber(readString(data, end), "Corrupted game data index"); c > 0; --c) {
+				string name(readString(data, end));
+				colors->emplace(name, readString(data, end));
+			}
+		}
+	}
+	return record;
+}
+
+GameIndex::~GameIndex() {
+	if (data)
+		munmap(const_cast<char*>(data), size);
+}
+
+bool GameIndex::open(const string& path) {
+
+	int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return false;
+
+	struct stat info;
+	if (fstat(fd, &info) or static_cast<size_t>(info.st_size) < sizeof(Header)) {
+		::close(fd);
+		return false;
+	}
+
+	void* map = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (map == MAP_FAILED)
+		return false;
+
+	data = static_cast<const char*>(map);
+	size = info.st_size;
+
+	const Header* header = reinterpret_cast<const Header*>(data);
+	bool valid =
+		not memcmp(header->magic, INDEX_MAGIC, sizeof(header->magic)) and
+		header->version == INDEX_VERSION and
+		sizeof(Header) + static_cast<size_t>(header->count) * sizeof(Entry) <= size;
+
+	if (valid) {
+		auto modified = getModified();
+		if (not std::equal(modified.begin(), modified.end(), header->modified)) {
+			LogNotice("Game data index is outdated, run emitter --build-index");
+			valid = false;
+		}
+	}
+	else {
+		LogNotice("Invalid game data index " + path);
+	}
+
+	if (not valid) {
+		munmap(map, size);
+		data = nullptr;
+		size = 0;
+		return false;
+	}
+	LogDebug("Using game data index with " + to_string(header->count) + " games");
+	return true;
+}
+
+bool GameIndex::isOpen() const {
+	return data;
+}
+
+bool GameIndex::find(const string& rom, Sources source, GameRecord& record) const {
+
+	if (not data)
+		return false;
+
+	const Header* header = reinterpret_cast<const Header*>(data);
+	const Entry*  first  = reinterpret_cast<const Entry*>(data + sizeof(Header));
+	const Entry*  last   = first + header->count;
+
+	auto key = [this](const Entry& entry) {
+		if (static_cast<size_t>(entry.key) + entry.keyLength > size)
+			throw Error("Corrupted game data index");
+		return std::string_view(data + entry.key, entry.keyLength);
+	};
+
+	const Entry* entry = std::lower_bound(first, last, rom, [&key](const Entry& entry, const string& rom) {
+		return key(entry) < rom;
+	});
+
+	if (entry == last or key(*entry) != rom or not entry->length[source])
+		return false;
+
+	if (static_cast<size_t>(entry->offset[source]) + entry->length[source] > size)
+		throw Error("Corrupted game data index");
+
+	record = GameRecord::deserialize(data + entry->offset[source], entry->length[source]);
+	return true;
+}
+
+size_t GameIndex::build(const string& path) {
+
+	auto modified = getModified();
+	if (std::all_of(modified.begin(), modified.end(), [](int64_t m) { return m == 0; }))
+		throw Error("No game data files found");
+
+	// Sorted by ROM, one record per source.
+	std::map<string, array<string, Sources::Count>> records;
+
+	// gameData.xml, one game per line.
+	std::ifstream file(CONTROLLERS_FILE);
+	string line;
+	while (std::getline(file, line)) {
+		Utility::trim(line);
+		if (line.compare(0, 3, "<M ") != 0)
+			continue;
+		tinyxml2::XMLDocument xml;
+		if (xml.Parse(line.c_str(), line.size()) != tinyxml2::XML_SUCCESS)
+			continue;
+		tinyxml2::XMLElement* element = xml.RootElement();
+		const char* rom = element->Attribute("n");
+		if (not rom)
+			continue;
+		try {
+			parseMameData(rom, element, true).serialize(records[rom][Sources::File]);
+		}
+		catch (Error& e) {
+			LogDebug(e.getMessage());
+		}
+	}
+
+	for (auto& section : readIniSections(CONTROLINI_FILE)) {
+		try {
+			parseControlsIniSection(section.first, section.second).serialize(records[section.first][Sources::ControlsIni]);
+		}
+		catch (Error& e) {
+			LogDebug(e.getMessage());
+		}
+	}
+
+	for (auto& section : readIniSections(COLORINI_FILE)) {
+		GameRecord colors(parseColorsIniSection(section.second));
+		if (not colors.playersData.empty())
+			colors.serialize(records[section.first][Sources::ColorsIni]);
+	}
+
+	Header header {};
+	memcpy(header.magic, INDEX_MAGIC, sizeof(header.magic));
+	header.version = INDEX_VERSION;
+	header.count   = records.size();
+	std::copy(modified.begin(), modified.end(), header.modified);
+
+	vector<Entry> entries;
+	entries.reserve(records.size());
+	string blob;
+	size_t base = sizeof(Header) + records.size() * sizeof(Entry);
+	for (auto& record : records) {
+		Entry entry {};
+		entry.key       = base + blob.size();
+		entry.keyLength = record.first.size();
+		blob += record.first;
+		for (uint8_t source = 0; source < Sources::Count; ++source) {
+			if (record.second[source].empty())
+				continue;
+			entry.offset[source] = base + blob.size();
+			entry.length[source] = record.second[source].size();
+			blob += record.second[source];
+		}
+		entries.push_back(entry);
+	}
+
+	// Replace the old index at once, running emitters keep their mapping.
+	string temporary(path + ".tmp");
+	std::ofstream output(temporary, std::ios::binary | std::ios::trunc);
+	output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	output.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(Entry));
+	output.write(blob.data(), blob.size());
+	output.close();
+	if (not output or rename(temporary.c_str(), path.c_str()))
+		throw Error("Unable to write ") << path;
+
+	return records.size();
+}
+
+array<int64_t, GameIndex::Sources::Count> GameIndex::getModified() {
+	array<int64_t, Sources::Count> modified {};
+	const char* files[] = {CONTROLLERS_FILE, CONTROLINI_FILE, COLORINI_FILE};
+	for (uint8_t source = 0; source < Sources::Count; ++source) {
+		struct stat info;
+		if (not stat(files[source], &info))
+			modified[source] = info.st_mtime;
+	}
+	return modified;
+}
+
+std::map<string, vector<string>> GameIndex::readIniSections(const string& file) {
+	std::map<string, vector<string>> sections;
+	std::ifstream input(file);
+	vector<string>* section = nullptr;
+	string line;
+	while (std::getline(input, line)) {
+		Utility::trim(line);
+		if (line.size() > 2 and line.front() == '[' and line.back() == ']') {
+			section = &sections[line.substr(1, line.size() - 2)];
+			continue;
+		}
+		if (section)
+			section->push_back(line);
+	}
+	return sections;
+}
+
+/* MAME cache */
+
+void MameCache::open(const string& path) {
+
+	this->path = path;
+	mameKey    = getMameKey();
+	current    = false;
+	records.clear();
+
+	std::ifstream input(path, std::ios::binary);
+	string key;
+	if (not input.is_open() or not std::getline(input, key))
+		return;
+	if (mameKey.empty() or key != mameKey) {
+		LogDebug("MAME changed, cache discarded");
+		return;
+	}
+	current = true;
+
+	const string content((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+	const char* data = content.data();
+	const char* end  = data + content.size();
+	try {
+		while (data < end) {
+			string rom(readString(data, end));
+			uint32_t length;
+			if (end - data < static_cast<ptrdiff_t>(sizeof(length)))
+				break;
+			memcpy(&length, data, sizeof(length));
+			data += sizeof(length);
+			if (static_cast<size_t>(end - data) < length)
+				break;
+			records[rom] = string(data, length);
+			data += length;
+		}
+	}
+	catch (Error& e) {
+		// A partial write at the end, keep what was read.
+	}
+	LogDebug("MAME cache with " + to_string(records.size()) + " games");
+}
+
+bool MameCache::find(const string& rom, GameRecord& record) const {
+	if (not records.exists(rom))
+		return false;
+	const string& data = records.at(rom);
+	record = GameRecord::deserialize(data.data(), data.size());
+	LogDebug("Game " + rom + " from MAME cache");
+	return true;
+}
+
+void MameCache::store(const string& rom, const GameRecord& record) {
+
+	if (path.empty() or mameKey.empty())
+		return;
+
+	string data;
+	record.serialize(data);
+
+	string entry;
+	writeString(entry, rom);
+	uint32_t length = data.size();
+	entry.append(reinterpret_cast<const char*>(&length), sizeof(length));
+	entry.append(data);
+	records[rom] = std::move(data);
+
+	// Start a new file when MAME changed.
+	std::ofstream output(path, std::ios::binary | (current ? std::ios::app : std::ios::trunc));
+	if (not output.is_open()) {
+		LogDebug("Unable to write " + path);
+		return;
+	}
+	if (not current)
+		output << mameKey << '\n';
+	output.write(entry.data(), entry.size());
+	current = true;
+}
+
+string MameCache::getDefaultPath() {
+	string configDir(Utility::getConfigDir());
+	struct stat st;
+	if (stat(configDir.c_str(), &st) != 0 and mkdir(configDir.c_str(), 0770) != 0)
+		LogDebug("Error: Unable to create directory " + configDir);
+	return configDir + MAME_CACHE_FILE;
+}
+
+string MameCache::getMameKey() {
+	const char* paths = getenv("PATH");
+	for (auto& dir : Utility::explode(paths ? paths : "", ':')) {
+		string binary((dir.empty() ? "." : dir) + "/" MAME_BINARY);
+		struct stat info;
+		if (stat(binary.c_str(), &info) == 0 and S_ISREG(info.st_mode))
+			return binary + " " + to_string(info.st_size) + " " + to_string(info.st_mtime);
+	}
+	return "";
+}
+
+size_t prewarmMameCache(const string& source) {
+
+	std::ifstream file;
+	if (source != "-") {
+		file.open(source);
+		if (not file.is_open())
+			throw Error("Unable to open ROM list ") << source;
+	}
+	std::istream& input(source == "-" ? std::cin : file);
+
+	// Stay out of the way of the running games.
+	if (nice(19) == -1)
+		LogDebug("Unable to lower the priority");
+
+	size_t added = 0;
+	string rom;
+	GameRecord gd;
+	while (std::getline(input, rom)) {
+		Utility::trim(rom);
+		if (rom.empty() or rom[0] == '#')
+			continue;
+		// ROM files are accepted too.
+		rom = Utility::explode(Utility::explode(rom, '/').back(), '.')[0];
+		if (mameCache.find(rom, gd))
+			continue;
+		try {
+			mameCache.store(rom, parseMame(rom));
+			++added;
+		}
+		catch (Error& e) {
+			LogDebug("Error: " + e.getMessage());
+		}
+	}
+	return added;
+}
@@ -21,7 +21,18 @@
  */
 
 #include <memory>
+#include <map>
 
+// For the game data index.
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+
+// To run the data sources without a shell.
+#include <spawn.h>
+#include <sys/wait.h>
+
+#include "client/Client.hpp"
 #include "utilities/Messages.hpp"
 #include "utilities/XMLHelper.hpp"
 
@@ -32,6 +43,12 @@
 #define DATA_SOURCE_FILE        "file"
 #define DATA_SOURCE_CONTROLSINI "controls.ini"
 
+#define PARAM_EMITTER_SOCKET "emitterSocket"
+#define PARAM_SOCKET_ALLOW   "socketAllow"
+
+/// Milliseconds to wait for requests before checking for termination.
+#define RESIDENT_WAIT 1000
+
 // dataSource fields.
 #define CONTROLLERS_FILE PROJECT_DATA_DIR "gameData.xml"
 #define CONTROL "C"
@@ -68,9 +85,22 @@
 
 #define COLORINI_FILE PROJECT_DATA_DIR "colors.ini"
 
+// Prebuilt index of the files above.
+#define INDEX_FILE    PROJECT_DATA_DIR "gameData.index"
+#define INDEX_MAGIC   "LSGI"
+#define INDEX_VERSION 1
+
+// Parsed mame -lx results, stored in the user config dir.
+#define MAME_BINARY     "mame"
+#define MAME_CACHE_FILE "mame.cache"
+
 bool ignoreMissingColors = false;
 
+/// True while running in resident mode.
+bool resident = false;
+
 using namespace LEDSpicer::Utilities;
+using LEDSpicer::Client;
 
 struct PlayerData {
 
@@ -113,6 +143,175 @@ struct GameRecord {
 	 * @param extraParameters
 	 */
 	void rotate(const string& extraParameters);
+
+	/**
+	 * Appends the record in binary form.
+	 * @param[out] output
+	 */
+	void serialize(string& output) const;
+
+	/**
+	 * Reads a record written by serialize.
+	 * @param data
+	 * @param size
+	 * @return the record.
+	 * @throws Error if the data is corrupted.
+	 */
+	static GameRecord deserialize(const char* data, size_t size);
+};
+
+/**
+ * Read only index of the game data files, keyed by ROM.
+ * Built by emitter --build-index, mapped in memory and searched with a binary search.
+ */
+class GameIndex {
+
+public:
+
+	/// Data files held by the index.
+	enum Sources : uint8_t {File, ControlsIni, ColorsIni, Count};
+
+	GameIndex() = default;
+
+	GameIndex(const GameIndex&) = delete;
+	GameIndex& operator=(const GameIndex&) = delete;
+
+	~GameIndex();
+
+	/**
+	 * Maps the index, it is ignored if missing or older than the data files.
+	 * @param path
+	 * @return true if the index can be used.
+	 */
+	bool open(const string& path);
+
+	/**
+	 * @return true if the index is mapped.
+	 */
+	bool isOpen() const;
+
+	/**
+	 * Finds a game.
+	 * @param rom
+	 * @param source
+	 * @param[out] record
+	 * @return true if the source has data for the game.
+	 */
+	bool find(const string& rom, Sources source, GameRecord& record) const;
+
+	/**
+	 * Parses the data files and writes a new index.
+	 * @param path
+	 * @return the number of games stored.
+	 * @throws Error if no data file was found or the index cannot be written.
+	 */
+	static size_t build(const string& path);
+
+private:
+
+	struct Header {
+		char     magic[4];
+		uint32_t version;
+		uint32_t count;
+		uint32_t reserved;
+		int64_t  modified[Sources::Count];
+	};
+
+	struct Entry {
+		uint32_t key;
+		uint32_t keyLength;
+		uint32_t offset[Sources::Count];
+		uint32_t length[Sources::Count];
+	};
+
+	/// Mapped file.
+	const char* data = nullptr;
+
+	/// Mapped size.
+	size_t size = 0;
+
+	/**
+	 * @return the modification time for each data file, 0 if missing.
+	 */
+	static array<int64_t, Sources::Count> getModified();
+
+	/**
+	 * Reads every section of an ini file.
+	 * @param file
+	 * @return the section lines by name.
+	 */
+	static std::map<string, vector<string>> readIniSections(const string& file);
+};
+
+/// Game data index, used when present and up to date.
+GameIndex gameIndex;
+
+/**
+ * On disk cache of the records parsed from mame -lx, filled as games are requested.
+ * The cache is tied to the MAME binary and is discarded when it changes.
+ */
+class MameCache {
+
+public:
+
+	/**
+	 * Loads the cache.
+	 * @param path
+	 */
+	void open(const string& path);
+
+	/**
+	 * @param rom
+	 * @param[out] record
+	 * @return true if the game is cached.
+	 */
+	bool find(const string& rom, GameRecord& record) const;
+
+	/**
+	 * Adds a game to the cache.
+	 * @param rom
+	 * @param record
+	 */
+	void store(const string& rom, const GameRecord& record);
+
+	/**
+	 * @return the cache file in the user config dir.
+	 */
+	static string getDefaultPath();
+
+private:
+
+	/// Cache file.
+	string path;
+
+	/// Identifies the MAME binary that produced the records.
+	string mameKey;
+
+	/// True if the file belongs to the current MAME binary.
+	bool current = false;
+
+	/// Serialized records by ROM.
+	unordered_map<string, string> records;
+
+	/**
+	 * @return the MAME binary path, size and modification time, empty if not found.
+	 */
+	static string getMameKey();
+};
+
+/// Cache for the mame data source.
+MameCache mameCache;
+
+/**
+ * Settings read from the configuration.
+ */
+struct EmitterSettings {
+	bool
+		craftProfile = false,
+		useColors    = false,
+		rotate       = false;
+	vector<string> dataSource;
+	string configFile;
 };
 
 /**
@@ -132,10 +331,81 @@ int main(int argc, char **argv);
  */
 string getNext(int index, int total, char **argv);
 
+/**
+ * Converts a LoadProfileByEmulator request into the profile request for ledspicerd,
+ * other requests are left untouched.
+ * @param msg the request, replaced with the translated message.
+ * @param settings
+ * @return false if the request is invalid.
+ */
+bool translate(Message& msg, const EmitterSettings& settings);
+
+/**
+ * ROM and system names reach the data sources and come from the network on resident mode.
+ * @param name
+ * @return true if the name only uses letters, numbers, underscores and dashes.
+ */
+bool isValidName(const string& name);
+
+/**
+ * Runs a program without a shell.
+ * @param arguments the program followed by its parameters.
+ * @return the program output.
+ * @throws Error if the program cannot be started.
+ */
+string runCommand(const vector<string>& arguments);
+
+/**
+ * Keeps translating requests until terminated.
+ * @param requests where the requests arrive.
+ * @param client connection to ledspicerd.
+ * @param settings
+ * @param binary true to use the binary protocol.
+ */
+void runResident(Messages& requests, Client& client, const EmitterSettings& settings, bool binary);
+
+/**
+ * Signal handler that ends the resident mode.
+ */
+void stopResident(int);
+
+/**
+ * Reads Set and Clear commands, one per line, into a batch message.
+ * Empty lines and lines starting with # are ignored.
+ * @param source file name, - for the standard input.
+ * @param msg the batch message.
+ * @throws Error if the file cannot be read or a command cannot be batched.
+ */
+void readBatch(const string& source, Message& msg);
+
 GameRecord parseMameDataFile(const string& rom);
 GameRecord parseMame(const string& rom);
 GameRecord parseControlsIni(const string& rom);
 
+/**
+ * Reads an ini file section.
+ * @param file
+ * @param rom
+ * @return the section lines trimmed, without the header.
+ */
+vector<string> readIniSection(const string& file, const string& rom);
+
+/**
+ * Parses a controls.ini section.
+ * @param rom
+ * @param lines
+ * @return the game record.
+ * @throws Error if the section has no valid player data.
+ */
+GameRecord parseControlsIniSection(const string& rom, const vector<string>& lines);
+
+/**
+ * Runs mame -lx for every ROM in a list that is not cached yet.
+ * @param source file with one ROM per line, - for the standard input.
+ * @return the number of games added.
+ */
+size_t prewarmMameCache(const string& source);
+
 /**
  * Decorate the game record with colors from the color.ini file.
  * @param rom
@@ -143,6 +413,20 @@ GameRecord parseControlsIni(const string& rom);
  */
 void decorateWithColorsIni(const string& rom, GameRecord& gr);
 
+/**
+ * Parses a colors.ini section.
+ * @param lines
+ * @return a game record holding only the colors.
+ */
+GameRecord parseColorsIniSection(const vector<string>& lines);
+
+/**
+ * Adds the colors from a record into another.
+ * @param colors
+ * @param gr
+ */
+void decorateWithColors(const GameRecord& colors, GameRecord& gr);
+
 /**
  * Process the mame game data.
  * examples:
@@ -44,8 +44,6 @@ class Handler {
 
 public:
 
-	Handler() = delete;
-
 	/**
 	 * Loads a new plugin using its library name.
 	 * @param the plugin library name without extension or path.
@@ -59,7 +57,12 @@ public:
 
 protected:
 
-	/// Pointer to the dynamic linked library.
+	/**
+	 * Creates a handler without library, used by plugins linked into the program.
+	 */
+	Handler() : handler(nullptr) {}
+
+	/// Pointer to the dynamic linked library, nullptr for built in plugins.
 	void* const handler;
 
 };
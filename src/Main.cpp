@@ -92,174 +92,250 @@ void Main::run() {
 		// Frame begins.
 		start = high_resolution_clock::now();
 
-		if (not messages.read()) {
-			currentProfile->runFrame();
-#ifdef BENCHMARK
-			// Time message needs reset.
-			timeMessage = {};
-			timeAnimation = duration_cast<milliseconds>(high_resolution_clock::now() - start);
-#endif
+		// Frames started by an input only redraw the inputs over the last frame.
+		if (inputFrame) {
+			currentProfile->runInputFrame();
 			sendData();
 			continue;
 		}
 
-		// If set, will replace currentProfile.
-		Profile* newProfile = nullptr;
-		// If set, will store the profile on the stack.
-		bool storeProfile   = false;
-
-		Message msg(messages.getMessage());
-		LogDebug("Received message: Task: " + Message::type2str(msg.getType()) + "\nData: " + msg.toHumanString() + "\nFlags: " + Message::flag2str(msg.getFlags()));
-		// Set global flags.
-		if (
-			msg.getType() == Message::Types::CraftProfile or
-			msg.getType() == Message::Types::LoadProfile  or
-			msg.getType() == Message::Types::FinishLastProfile
-		) {
-			Utility::globalFlags = msg.getFlags();
+		// Handle the pending messages up to the budget, the rest waits for the next frame.
+		if (messages.read()) {
+			for (uint16_t handled = 0; handled < DataLoader::messageBudget and messages.hasMessages(); ++handled)
+				processMessage(messages.getMessage());
 		}
+#ifdef BENCHMARK
+		timeMessage = duration_cast<milliseconds>(high_resolution_clock::now() - start);
+#endif
 
-		switch (msg.getType()) {
+		currentProfile->runFrame();
+#ifdef BENCHMARK
+		timeAnimation = duration_cast<milliseconds>(high_resolution_clock::now() - start) - timeMessage;
+#endif
+		sendData();
+	}
+	// Terminate execution with the ending transition.
+	changeProfile(nullptr, false);
+}
 
-		case Message::Types::LoadProfile:
-			newProfile = tryProfiles(msg.getData());
-			if (not newProfile) {
-				LogInfo("All requested profiles failed");
-				break;
-			}
-			storeProfile = true;
-			break;
+void Main::processMessage(const Message& msg) {
+
+	// If set, will replace currentProfile.
+	Profile* newProfile = nullptr;
+	// If set, will store the profile on the stack.
+	bool storeProfile   = false;
+
+	LogDebug("Received message: Task: " + Message::type2str(msg.getType()) + "\nData: " + msg.toHumanString() + "\nFlags: " + Message::flag2str(msg.getFlags()));
+	// Set global flags.
+	if (
+		msg.getType() == Message::Types::CraftProfile or
+		msg.getType() == Message::Types::LoadProfile  or
+		msg.getType() == Message::Types::FinishLastProfile
+	) {
+		Utility::globalFlags = msg.getFlags();
+	}
 
-		case Message::Types::FinishLastProfile:
-			if (not profiles.size()) break;
-			LogInfo("Profile " + currentProfile->getName() + " terminated");
-			profiles.pop_back();
-			if (profiles.size())
-				newProfile = profiles.back();
-			else
-				newProfile = Profile::defaultProfile;
-			storeProfile = false;
-			break;
+	switch (msg.getType()) {
 
-		case Message::Types::FinishAllProfiles:
-			if (not profiles.size()) break;
-			profiles.clear();
-			newProfile   = Profile::defaultProfile;
-			storeProfile = false;
+	case Message::Types::LoadProfile:
+		newProfile = tryProfiles(msg.getData());
+		if (not newProfile) {
+			LogInfo("All requested profiles failed");
 			break;
+		}
+		storeProfile = true;
+		break;
 
-		case Message::Types::SetElement: {
-			if (msg.getData().size() < 1 or not Element::allElements.exists(msg.getData()[0])) {
-				LogNotice("Invalid message for " + Message::type2str(msg.getType()));
-				break;
-			}
+	case Message::Types::FinishLastProfile:
+		if (not profiles.size()) break;
+		LogInfo("Profile " + currentProfile->getName() + " terminated");
+		profiles.pop_back();
+		if (profiles.size())
+			newProfile = profiles.back();
+		else
+			newProfile = Profile::defaultProfile;
+		storeProfile = false;
+		break;
 
-			if (msg.getData().size() == 1)
-				msg.addData(Element::allElements.at(msg.getData()[0])->getDefaultColor().getName());
+	case Message::Types::FinishAllProfiles:
+		if (not profiles.size()) break;
+		profiles.clear();
+		newProfile   = Profile::defaultProfile;
+		storeProfile = false;
+		break;
 
-			if (msg.getData().size() == 2)
-				msg.addData("Normal");
+	case Message::Types::SetElement:
+	case Message::Types::ClearElement:
+	case Message::Types::ClearAllElements:
+	case Message::Types::SetGroup:
+	case Message::Types::ClearGroup:
+	case Message::Types::ClearAllGroups:
+		applyOperation(msg);
+		break;
 
-			try {
-				Profile::addTemporaryOnElement(
-					msg.getData()[0], Element::Item{
-						Element::allElements.at(msg.getData()[0]),
-						&Color::getColor(msg.getData()[1]),
-						Color::str2filter(msg.getData()[2])
-					}
-				);
-			}
-			catch (Error& e) {
-				LogNotice(e.getMessage());
+	case Message::Types::Batch:
+		// All the operations land before the next frame, binary ones keep their ids.
+		for (const auto& operation : msg.getOperations()) {
+			if (operation.getType() == Message::Types::Invalid) {
+				LogNotice("Invalid operation in " + Message::type2str(Message::Types::Batch));
+				continue;
 			}
-			break;
+			applyOperation(operation);
 		}
+		break;
 
-		case Message::Types::ClearElement:
-			if (msg.getData().size() != 1) {
-				LogNotice("Invalid element in message for " + Message::type2str(Message::Types::ClearElement));
-				break;
-			}
-			Profile::removeTemporaryOnElement(msg.getData()[0]);
+	case Message::Types::CraftProfile: {
+		/*
+		 * 0 target name
+		 * 1 elements
+		 * 2 groups
+		 * 3 system
+		 */
+		if (msg.getData().size() != 4) {
+			LogNotice("Invalid message for " + Message::type2str(Message::Types::CraftProfile));
 			break;
+		}
+		newProfile   = tryProfiles({msg.getData()[0]});
+		storeProfile = true;
+		if (not newProfile) {
+			// Craft profile.
+			newProfile = craftProfile(msg.getData()[0], msg.getData()[3], msg.getData()[1], msg.getData()[2]);
+			// Try platform profile.
+			if (not newProfile) newProfile = tryProfiles({msg.getData()[3]});
+		}
+		break;
+	}
+	// Other request that are not handled yet by ledspicerd.
+	default: break;
+	}
+	if (newProfile) {
+		newProfile->enableAnimations(not (Utility::globalFlags & FLAG_NO_ANIMATIONS));
+		newProfile->enableInputs(not (Utility::globalFlags & FLAG_NO_INPUTS));
+		changeProfile(newProfile, storeProfile);
+	}
+}
 
-		case Message::Types::ClearAllElements:
-			Profile::removeTemporaryOnElements();
-			break;
+void Main::applyOperation(const Message& msg) {
 
-		case Message::Types::SetGroup:
-			if (msg.getData().size() < 1 or not Group::layout.exists(msg.getData()[0])) {
-				LogNotice("Missing/Invalid group for " + Message::type2str(Message::Types::SetGroup));
-				break;
-			}
+	switch (msg.getType()) {
 
-			if (msg.getData().size() == 1)
-				msg.addData(Group::layout.at(msg.getData()[0]).getDefaultColor().getName());
+	case Message::Types::SetElement: {
+		Element* element = getElement(msg, 0);
+		if (not element) {
+			LogNotice("Invalid message for " + Message::type2str(msg.getType()));
+			break;
+		}
 
-			if (msg.getData().size() == 2)
-				msg.addData("Normal");
+		try {
+			Profile::addTemporaryOnElement(
+				element->getName(), Element::Item{
+					element,
+					&getColor(msg, 1, element->getDefaultColor()),
+					getFilter(msg, 2)
+				}
+			);
+		}
+		catch (Error& e) {
+			LogNotice(e.getMessage());
+		}
+		break;
+	}
 
-			try {
-				Profile::addTemporaryOnGroup(
-					msg.getData()[0], Group::Item{
-						&Group::layout.at(msg.getData()[0]),
-						&Color::getColor(msg.getData()[1]),
-						Color::str2filter(msg.getData()[2])
-					}
-				);
-			}
-			catch (Error& e) {
-				LogNotice(e.getMessage());
-			}
+	case Message::Types::ClearElement: {
+		Element* element = msg.getData().size() == 1 ? getElement(msg, 0) : nullptr;
+		if (not element) {
+			LogNotice("Invalid element in message for " + Message::type2str(Message::Types::ClearElement));
 			break;
+		}
+		Profile::removeTemporaryOnElement(element->getName());
+		break;
+	}
 
-		case Message::Types::ClearGroup:
-			if (msg.getData().size() != 1 or not Group::layout.exists(msg.getData()[0])) {
-				LogNotice("Unknown group for " + Message::type2str(Message::Types::ClearGroup));
-				break;
-			}
-			Profile::removeTemporaryOnGroup(msg.getData()[0]);
-			break;
+	case Message::Types::ClearAllElements:
+		Profile::removeTemporaryOnElements();
+		break;
 
-		case Message::Types::ClearAllGroups:
-			Profile::removeTemporaryOnGroups();
+	case Message::Types::SetGroup: {
+		Group* group = getGroup(msg, 0);
+		if (not group) {
+			LogNotice("Missing/Invalid group for " + Message::type2str(Message::Types::SetGroup));
 			break;
+		}
 
-		case Message::Types::CraftProfile: {
-			/*
-			 * 0 target name
-			 * 1 elements
-			 * 2 groups
-			 * 3 system
-			 */
-			if (msg.getData().size() != 4) {
-				LogNotice("Invalid message for " + Message::type2str(Message::Types::CraftProfile));
-				break;
-			}
-			newProfile   = tryProfiles({msg.getData()[0]});
-			storeProfile = true;
-			if (not newProfile) {
-				// Craft profile.
-				newProfile = craftProfile(msg.getData()[0], msg.getData()[3], msg.getData()[1], msg.getData()[2]);
-				// Try platform profile.
-				if (not newProfile) newProfile = tryProfiles({msg.getData()[3]});
-			}
-			break;
+		try {
+			Profile::addTemporaryOnGroup(
+				group->getName(), Group::Item{
+					group,
+					&getColor(msg, 1, group->getDefaultColor()),
+					getFilter(msg, 2)
+				}
+			);
 		}
-		// Other request that are not handled yet by ledspicerd.
-		default: break;
+		catch (Error& e) {
+			LogNotice(e.getMessage());
 		}
-#ifdef BENCHMARK
-		timeMessage = duration_cast<milliseconds>(high_resolution_clock::now() - start);
-#endif
-		if (newProfile) {
-			newProfile->enableAnimations(not (Utility::globalFlags & FLAG_NO_ANIMATIONS));
-			newProfile->enableInputs(not (Utility::globalFlags & FLAG_NO_INPUTS));
-			changeProfile(newProfile, storeProfile);
+		break;
+	}
+
+	case Message::Types::ClearGroup: {
+		Group* group = msg.getData().size() == 1 ? getGroup(msg, 0) : nullptr;
+		if (not group) {
+			LogNotice("Unknown group for " + Message::type2str(Message::Types::ClearGroup));
+			break;
 		}
+		Profile::removeTemporaryOnGroup(group->getName());
+		break;
 	}
-	// Terminate execution with the ending transition.
-	changeProfile(nullptr, false);
+
+	case Message::Types::ClearAllGroups:
+		Profile::removeTemporaryOnGroups();
+		break;
+
+	default:
+		break;
+	}
+}
+
+Element* Main::getElement(const Message& msg, size_t field) const {
+	if (msg.getData().size() <= field)
+		return nullptr;
+	uint16_t id = msg.getId(field);
+	if (id != NO_ID)
+		return id < elementsById.size() ? elementsById[id] : nullptr;
+	auto element = Element::allElements.find(msg.getData()[field]);
+	return element == Element::allElements.end() ? nullptr : element->second;
+}
+
+Group* Main::getGroup(const Message& msg, size_t field) const {
+	if (msg.getData().size() <= field)
+		return nullptr;
+	uint16_t id = msg.getId(field);
+	if (id != NO_ID)
+		return id < groupsById.size() ? groupsById[id] : nullptr;
+	auto group = Group::layout.find(msg.getData()[field]);
+	return group == Group::layout.end() ? nullptr : &group->second;
+}
+
+const Color& Main::getColor(const Message& msg, size_t field, const Color& defaultColor) const {
+	if (msg.getData().size() <= field)
+		return defaultColor;
+	uint16_t id = msg.getId(field);
+	if (id == NO_ID)
+		return Color::getColor(msg.getData()[field]);
+	if (id >= colorsById.size())
+		throw Error("Unknown color id ") << to_string(id);
+	return *colorsById[id];
+}
+
+Color::Filters Main::getFilter(const Message& msg, size_t field) const {
+	if (msg.getData().size() <= field)
+		return Color::Filters::Normal;
+	uint16_t id = msg.getId(field);
+	if (id == NO_ID)
+		return Color::str2filter(msg.getData()[field]);
+	if (id > static_cast<uint16_t>(Color::Filters::Multiply))
+		throw Error("Invalid filter id ") << to_string(id);
+	return static_cast<Color::Filters>(id);
 }
 
 void Main::terminate() {
@@ -274,7 +350,10 @@ int main(int argc, char **argv) {
 		profile,
 		configFile = "",
 		projectDir = "",
-		project    = "";
+		project    = "",
+		recordFile = "",
+		replayFile = "",
+		seed       = "";
 
 	for (int i = 1; i < argc; i++) {
 
@@ -294,6 +373,9 @@ int main(int argc, char **argv) {
 				"-J <path> or --projects-dir <path>\tOverride projects base directory\n"
 				"-l or --leds\t\t\t\tTest LEDs.\n"
 				"-e or --elements\t\t\tTest registered elements.\n"
+				"-r <file> or --record <file>\t\tRecord the inputs, messages and audio into a file\n"
+				"-R <file> or --replay <file>\t\tReplay a recording on foreground and quit\n"
+				"-s <seed> or --seed <seed>\t\tUse a fixed seed for the random animations\n"
 				"-v or --version\t\t\t\tDisplay version information\n"
 				"-h or --help\t\t\t\tDisplay this help screen.\n"
 				"Data dir:     " PROJECT_DATA_DIR "\n"
@@ -360,6 +442,25 @@ int main(int argc, char **argv) {
 			continue;
 		}
 
+		// Record session.
+		if (commandline == "-r" or commandline == "--record") {
+			recordFile = argv[++i];
+			continue;
+		}
+
+		// Replay session.
+		if (commandline == "-R" or commandline == "--replay") {
+			replayFile = argv[++i];
+			DataLoader::setMode(DataLoader::Modes::Foreground);
+			continue;
+		}
+
+		// Random seed.
+		if (commandline == "-s" or commandline == "--seed") {
+			seed = argv[++i];
+			continue;
+		}
+
 		// Force foreground.
 		if (DataLoader::getMode() == DataLoader::Modes::Normal and (commandline == "-f" or commandline == "--foreground")) {
 			DataLoader::setMode(DataLoader::Modes::Foreground);
@@ -372,11 +473,13 @@ int main(int argc, char **argv) {
 	Log::initialize(DataLoader::getMode() != DataLoader::Modes::Normal);
 
 	if (configFile.empty()) configFile = CONFIG_FILE;
-	// seed the random here, because loader uses it.
-	std::srand(time(nullptr));
 
 	try {
 
+		// seed the random here, because loader uses it.
+		RandomGenerator::setSeed(seed.empty() ? time(nullptr) : Utility::parseNumber(seed, "Invalid seed"));
+		seed.clear();
+
 		signal(SIGSEGV, signalHandler);
 		signal(SIGILL,  signalHandler);
 		signal(SIGFPE,  signalHandler);
@@ -390,6 +493,12 @@ int main(int argc, char **argv) {
 		// Ignored signals
 		signal(SIGPIPE, reinterpret_cast<__sighandler_t>(1));
 
+		// Recordings reseed the random before the loader uses it.
+		if (not replayFile.empty())
+			Recorder::startReplay(replayFile);
+		else if (not recordFile.empty())
+			Recorder::startRecording(recordFile);
+
 		// Read Configuration.
 		DataLoader config(configFile, "Configuration");
 		config.readConfiguration(projectDir, project, profile);
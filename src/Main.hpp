@@ -84,6 +84,53 @@ protected:
 	 */
 	void changeProfile(Profile* to, bool store);
 
+	/**
+	 * Handles a message from the queue.
+	 * @param msg
+	 */
+	void processMessage(const Message& msg);
+
+	/**
+	 * Applies a Set or Clear message.
+	 * @param msg
+	 */
+	void applyOperation(const Message& msg);
+
+	/**
+	 * Finds the element of a message field, by name or interned id.
+	 * @param msg
+	 * @param field
+	 * @return the element, nullptr if not found.
+	 */
+	Element* getElement(const Message& msg, size_t field) const;
+
+	/**
+	 * Finds the group of a message field, by name or interned id.
+	 * @param msg
+	 * @param field
+	 * @return the group, nullptr if not found.
+	 */
+	Group* getGroup(const Message& msg, size_t field) const;
+
+	/**
+	 * Finds the color of a message field, by name or interned id.
+	 * @param msg
+	 * @param field
+	 * @param defaultColor used when the field is missing.
+	 * @return the color.
+	 * @throws Error if the color does not exist.
+	 */
+	const Color& getColor(const Message& msg, size_t field, const Color& defaultColor) const;
+
+	/**
+	 * Finds the filter of a message field, by name or id (Color::Filters value).
+	 * @param msg
+	 * @param field
+	 * @return the filter, Normal if the field is missing.
+	 * @throws Error if the filter does not exist.
+	 */
+	Color::Filters getFilter(const Message& msg, size_t field) const;
+
 };
 
 /**
@@ -25,14 +25,27 @@
 using namespace LEDSpicer;
 
 bool MainBase::running = false;
+vector<Element*> MainBase::elementsById;
+vector<Group*> MainBase::groupsById;
+vector<const Color*> MainBase::colorsById;
 
 MainBase::MainBase() :
+	// Replays do not listen, the messages come from the recording.
 	messages(
-		DataLoader::getMode() == DataLoader::Modes::Normal or
-		DataLoader::getMode() == DataLoader::Modes::Foreground ? DataLoader::portNumber : ""
+		(DataLoader::getMode() == DataLoader::Modes::Normal or
+		DataLoader::getMode() == DataLoader::Modes::Foreground) and not Recorder::isReplaying() ? DataLoader::portNumber : "",
+		(DataLoader::getMode() == DataLoader::Modes::Normal or
+		DataLoader::getMode() == DataLoader::Modes::Foreground) and not Recorder::isReplaying() ? DataLoader::socketPath : "",
+		DataLoader::socketType,
+		DataLoader::socketAllow
 	)
 {
 
+	buildIds();
+
+	// Input frames redraw the inputs over the last frame.
+	Profile::keepFrame = DataLoader::reactiveInputs;
+
 	switch (DataLoader::getMode()) {
 	case DataLoader::Modes::Dump:
 	case DataLoader::Modes::Profile:
@@ -50,10 +63,20 @@ MainBase::MainBase() :
 #endif
 
 	running = true;
+
+	if (DataLoader::getMode() == DataLoader::Modes::Normal or DataLoader::getMode() == DataLoader::Modes::Foreground) {
+		startTransferThreads();
+		if (not DataLoader::streamPath.empty())
+			startFrameStream();
+	}
 }
 
 MainBase::~MainBase() {
 
+	stopTransferThreads();
+
+	Recorder::stop();
+
 	for (auto& dh : DeviceHandler::deviceHandlers) {
 		delete dh.second;
 #ifdef DEVELOP
@@ -147,11 +170,17 @@ void MainBase::dumpConfiguration() {
 	cout << endl << "System Configuration:" << endl << "Colors:" << endl;
 	Color::drawColors();
 	cout  << endl << "Hardware:" << endl;
-	for (auto d : Device::devices)
+	for (auto d : Device::devices) {
 		d->drawHardwareLedMap();
+		if (d->getMaxRefresh())
+			cout << "Maximum refresh: " << to_string(d->getMaxRefresh()) << "Hz" << endl;
+	}
 	cout <<
 		"Log level: " << Log::level2str(Log::getLogLevel()) << endl <<
 		"Interval: " << DataLoader::waitTime.count() << "ms" << endl <<
+		"Messages per frame: " << DataLoader::messageBudget << endl <<
+		"Frame stream: " << (DataLoader::streamPath.empty() ? "disabled" : DataLoader::streamPath) << endl <<
+		"Reactive inputs: " << (DataLoader::reactiveInputs ? "Yes" : "No") << endl <<
 		"Total Elements registered: " << static_cast<uint16_t>(Element::allElements.size()) << endl << endl <<
 		"Layout:";
 	for (auto group : Group::layout) {
@@ -166,7 +195,16 @@ void MainBase::dumpConfiguration() {
 	for (auto element : Element::allElements)
 		element.second->drawConfig();
 
-	cout << endl;
+	cout << endl << "Binary protocol ids:" << endl << "Elements:";
+	for (uint16_t id = 0; id < elementsById.size(); ++id)
+		cout << (id % 4 ? " | " : "\n") << std::setw(5) << std::right << id << " " << std::setw(20) << std::left << elementsById[id]->getName();
+	cout << endl << "Groups:";
+	for (uint16_t id = 0; id < groupsById.size(); ++id)
+		cout << (id % 4 ? " | " : "\n") << std::setw(5) << std::right << id << " " << std::setw(20) << std::left << groupsById[id]->getName();
+	cout << endl << "Colors:";
+	for (uint16_t id = 0; id < colorsById.size(); ++id)
+		cout << (id % 4 ? " | " : "\n") << std::setw(5) << std::right << id << " " << std::setw(20) << std::left << colorsById[id]->getName();
+	cout << endl << endl;
 }
 
 void MainBase::dumpProfile() {
@@ -179,6 +217,32 @@ void MainBase::dumpProfile() {
 	cout << endl;
 }
 
+void MainBase::buildIds() {
+
+	vector<string> names;
+
+	elementsById.clear();
+	for (auto& element : Element::allElements)
+		names.push_back(element.first);
+	std::sort(names.begin(), names.end());
+	for (auto& name : names)
+		elementsById.push_back(Element::allElements.at(name));
+
+	names.clear();
+	groupsById.clear();
+	for (auto& group : Group::layout)
+		names.push_back(group.first);
+	std::sort(names.begin(), names.end());
+	for (auto& name : names)
+		groupsById.push_back(&Group::layout.at(name));
+
+	names = Color::getNames();
+	colorsById.clear();
+	std::sort(names.begin(), names.end());
+	for (auto& name : names)
+		colorsById.push_back(&Color::getColor(name));
+}
+
 Device* MainBase::selectDevice() {
 
 	if (Device::devices.size() == 1)
@@ -208,16 +272,27 @@ Device* MainBase::selectDevice() {
 }
 
 void MainBase::wait(milliseconds wasted) {
-	if (wasted <= DataLoader::waitTime) {
-		start = high_resolution_clock::now();
-		sleep_for(DataLoader::waitTime - wasted);
+	// Replays run as fast as they can.
+	if (Recorder::isReplaying())
+		return;
+	// Input frames keep the schedule, the animations only advance every waitTime.
+	if (not inputFrame) {
+		nextFrame = start + DataLoader::waitTime;
+		if (wasted > DataLoader::waitTime)
+			LogInfo("The frame took " + to_string(wasted.count()) + "ms to render, that is longer than the minimal wait time of " + to_string(DataLoader::waitTime.count()) + "ms.");
+	}
+	inputFrame = false;
+	start = high_resolution_clock::now();
+	if (nextFrame > start) {
+		// An input before the next frame is due only redraws the inputs, recordings only keep the frames that advance.
+		if (DataLoader::reactiveInputs and not Profile::isTransitioning() and not Recorder::isRecording())
+			inputFrame = Reader::waitForInput(duration_cast<milliseconds>(nextFrame - start));
+		else
+			std::this_thread::sleep_until(nextFrame);
 #ifdef BENCHMARK
 		LogDebug("Waited time: " + to_string(duration_cast<milliseconds>(high_resolution_clock::now() - start).count()) + "ms");
 #endif
 	}
-	else {
-		LogInfo("The frame took " + to_string(wasted.count()) + "ms to render, that is longer than the minimal wait time of " + to_string(DataLoader::waitTime.count()) + "ms.");
-	}
 #ifdef BENCHMARK
 	LogDebug("Message time: " + to_string(timeMessage.count()) + "ms, Animation Time: " + to_string(timeAnimation.count()) + "ms, Transmission time: " + to_string(timeTransfer.count()) + "ms.");
 #endif
@@ -225,15 +300,172 @@ void MainBase::wait(milliseconds wasted) {
 
 void MainBase::sendData() {
 	// Send data.
-	// TODO: need to test speed: single thread or running one thread per device.
 #ifdef BENCHMARK
 	startTransfer = high_resolution_clock::now();
 #endif
+	// Subscribers see the frame before the transfer threads start reading it.
+	if (frameStream)
+		publishFrame();
+	if (Recorder::isRecording() or Recorder::isReplaying())
+		Recorder::output(hashFrame());
+	// Strip shards go out in parallel while the rest is sent from here.
+	if (transferThreads.size()) {
+		std::lock_guard<std::mutex> lock(transferMutex);
+		transferPending = transferThreads.size();
+		++transferRound;
+		transferStart.notify_all();
+	}
 	for (auto device : Device::devices)
-		device->packData();
+		if (not device->isConcurrentTransfer())
+			device->packData();
+	if (transferThreads.size()) {
+		std::unique_lock<std::mutex> lock(transferMutex);
+		transferDone.wait(lock, [&] { return transferPending == 0; });
+		if (not transferError.empty()) {
+			string error(std::move(transferError));
+			transferError.clear();
+			throw Error(error);
+		}
+	}
 #ifdef BENCHMARK
 	timeTransfer = duration_cast<milliseconds>(high_resolution_clock::now() - startTransfer);
 #endif
+	Reader::reportLatency();
 	// Wait...
 	wait(duration_cast<milliseconds>(high_resolution_clock::now() - start));
+	if (not Recorder::newFrame())
+		running = false;
+}
+
+void MainBase::startFrameStream() {
+
+	frameStream.reset(new FrameStream(
+		DataLoader::streamPath,
+		static_cast<uint8_t>(1000 / DataLoader::waitTime.count()),
+		DataLoader::socketAllow
+	));
+
+	// Devices are laid one after the other.
+	struct Range {
+		const uint8_t* first;
+		uint16_t size;
+		size_t offset;
+	};
+	vector<Range> ranges;
+	std::stringstream metadata;
+	size_t offset = 0;
+	metadata << "fps\t" << 1000 / DataLoader::waitTime.count() << "\n";
+	for (auto device : Device::devices) {
+		uint16_t size = device->getNumberOfLeds();
+		metadata << "device\t" << device->getFullName() << "\t" << offset << "\t" << size << "\n";
+		if (size)
+			ranges.push_back(Range{device->getLed(0), size, offset});
+		offset += size;
+	}
+	streamFrame.resize(offset);
+
+	for (auto element : elementsById) {
+		metadata << "element\t" << element->getName() << "\t";
+		bool first = true;
+		for (auto led : element->getLeds()) {
+			for (auto& range : ranges) {
+				if (led < range.first or led >= range.first + range.size)
+					continue;
+				metadata << (first ? "" : ",") << range.offset + (led - range.first);
+				first = false;
+				break;
+			}
+		}
+		metadata << "\n";
+	}
+
+	for (auto group : groupsById) {
+		metadata << "group\t" << group->getName() << "\t";
+		bool first = true;
+		for (auto element : group->getElements()) {
+			metadata << (first ? "" : ",") << element->getName();
+			first = false;
+		}
+		metadata << "\n";
+	}
+	frameStream->setMetadata(metadata.str());
+}
+
+void MainBase::publishFrame() {
+	auto position = streamFrame.begin();
+	for (auto device : Device::devices) {
+		uint16_t size = device->getNumberOfLeds();
+		if (not size)
+			continue;
+		const uint8_t* first = device->getLed(0);
+		position = std::copy(first, first + size, position);
+	}
+	frameStream->publish(streamFrame);
+}
+
+uint64_t MainBase::hashFrame() const {
+	// FNV-1a.
+	uint64_t hash = 14695981039346656037ULL;
+	for (auto device : Device::devices) {
+		uint16_t size = device->getNumberOfLeds();
+		if (not size)
+			continue;
+		const uint8_t* leds = device->getLed(0);
+		for (uint16_t c = 0; c < size; ++c)
+			hash = (hash ^ leds[c]) * 1099511628211ULL;
+	}
+	return hash;
+}
+
+void MainBase::startTransferThreads() {
+	for (auto device : Device::devices) {
+		if (not device->isConcurrentTransfer())
+			continue;
+		LogDebug("Starting transfer thread for " + device->getFullName());
+		transferThreads.emplace_back(&MainBase::transferThread, this, device);
+	}
+}
+
+void MainBase::stopTransferThreads() {
+	if (transferThreads.empty())
+		return;
+	{
+		std::lock_guard<std::mutex> lock(transferMutex);
+		transferStop = true;
+		transferStart.notify_all();
+	}
+	for (auto& thread : transferThreads)
+		thread.join();
+	transferThreads.clear();
+}
+
+void MainBase::transferThread(Device* device) {
+	uint32_t round = 0;
+	std::unique_lock<std::mutex> lock(transferMutex);
+	while (true) {
+		transferStart.wait(lock, [&] { return transferStop or round != transferRound; });
+		if (transferStop)
+			return;
+		round = transferRound;
+		lock.unlock();
+		string error;
+		try {
+			device->packData();
+		}
+		catch (Error& e) {
+			error = e.getMessage();
+		}
+		// Anything escaping the thread would terminate the program.
+		catch (std::exception& e) {
+			error = string("Transfer failed: ") + e.what();
+		}
+		catch (...) {
+			error = "Transfer failed";
+		}
+		lock.lock();
+		if (not error.empty())
+			transferError = error;
+		if (--transferPending == 0)
+			transferDone.notify_one();
+	}
 }
@@ -22,6 +22,9 @@
 
 #include "DataLoader.hpp"
 #include "utilities/USB.hpp"
+#include "utilities/FrameStream.hpp"
+#include <mutex>
+#include <condition_variable>
 
 namespace LEDSpicer {
 
@@ -57,6 +60,11 @@ public:
 	 */
 	void dumpProfile();
 
+	/**
+	 * Interns elements, groups and colors by id, sorted by name, used by the binary protocol.
+	 */
+	static void buildIds();
+
 	/**
 	 * Waits for a defined amount of ms.
 	 * @param milliseconds wasted keeps track of the wasted milliseconds.
@@ -71,6 +79,15 @@ protected:
 	/// Keeps messages incoming.
 	Messages messages;
 
+	/// Elements by interned id.
+	static vector<Element*> elementsById;
+
+	/// Groups by interned id.
+	static vector<Group*> groupsById;
+
+	/// Colors by interned id.
+	static vector<const Color*> colorsById;
+
 	/// Keeps a reference to profile in focus.
 	Profile* currentProfile = nullptr;
 
@@ -81,6 +98,12 @@ protected:
 	 */
 	vector<Profile*> profiles;
 
+	/// When the next frame that advances the animations is due.
+	high_resolution_clock::time_point nextFrame;
+
+	/// True if the wait ended early because of an input, the next frame only redraws the inputs.
+	bool inputFrame = false;
+
 	/// Starting point for the frame.
 	high_resolution_clock::time_point
 #ifdef BENCHMARK
@@ -105,6 +128,69 @@ protected:
 	 * Send data to all devices.
 	 */
 	void sendData();
+
+private:
+
+	/// Threads transferring the devices that hold strip shards.
+	vector<std::thread> transferThreads;
+
+	/// Protects the transfer frame and pending counters.
+	std::mutex transferMutex;
+
+	/// Signals the threads to transfer and the main thread when done.
+	std::condition_variable
+		transferStart,
+		transferDone;
+
+	/// Transfer round, every thread runs once per round.
+	uint32_t transferRound = 0;
+
+	/// Number of threads that did not finish the current round.
+	uint8_t transferPending = 0;
+
+	/// Stops the transfer threads.
+	bool transferStop = false;
+
+	/// Keeps the last error from a transfer thread, rethrown by the main thread.
+	string transferError;
+
+	/// Publishes the frames to the subscribers, null if disabled.
+	std::unique_ptr<FrameStream> frameStream;
+
+	/// LEDs of all the devices, reused between frames.
+	vector<uint8_t> streamFrame;
+
+	/**
+	 * Starts one thread for every device with concurrent transfer.
+	 */
+	void startTransferThreads();
+
+	/**
+	 * Stops and joins the transfer threads.
+	 */
+	void stopTransferThreads();
+
+	/**
+	 * Creates the frame stream and the metadata with the devices, elements and groups.
+	 * Elements list the LEDs by their position on the stream frame.
+	 */
+	void startFrameStream();
+
+	/**
+	 * Copies the LEDs of all the devices into the stream frame and publishes it.
+	 */
+	void publishFrame();
+
+	/**
+	 * @return a hash of the LEDs of all the devices, to compare replays with their recording.
+	 */
+	uint64_t hashFrame() const;
+
+	/**
+	 * Transfer loop for a single device.
+	 * @param device
+	 */
+	void transferThread(Device* device);
 };
 
 } // namespace
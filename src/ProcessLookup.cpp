@@ -35,17 +35,56 @@ Map* currentMap = nullptr;
 
 unordered_map<string, Map> maps;
 
+Client* Target::get() {
+	if (not client) {
+		try {
+			client = std::make_unique<Client>(port, socket, socketType);
+		}
+		catch (Error& e) {
+			LogWarning(e.getMessage());
+		}
+	}
+	return client.get();
+}
+
 void callEmitter(const string& rom, const string& system = "") {
-	string parameters(currentConfigFile != CONFIG_FILE ? "-c \"" + currentConfigFile + "\"" : "");
-	string command;
-	if (rom.empty())
-		command = "emitter FinishLastProfile " + parameters;
-	else
-		command = "emitter LoadProfileByEmulator " + rom + " " + system + " " + parameters;
-	LogDebug("Running: " + command);
-	if (std::system(command.c_str()) != EXIT_SUCCESS) {
-		LogWarning("Failed to execute " + command);
+
+	// Finish goes straight to ledspicerd.
+	if (rom.empty()) {
+		LogDebug("Sending FinishLastProfile");
+		Client* client = ledspicerd.get();
+		if (not client or not client->finishLastProfile()) {
+			LogWarning("Failed to send FinishLastProfile");
+			ledspicerd.client.reset();
+		}
+		return;
 	}
+
+	if (emitter.isSet()) {
+		LogDebug("Sending LoadProfileByEmulator " + rom + " " + system);
+		Client* client = emitter.get();
+		if (client and client->loadProfileByEmulator(rom, system))
+			return;
+		LogWarning("Resident emitter not available");
+		emitter.client.reset();
+	}
+
+	// No resident emitter, start one for this request.
+	vector<string> arguments {"emitter", "LoadProfileByEmulator", rom, system};
+	if (currentConfigFile != CONFIG_FILE) {
+		arguments.push_back("-c");
+		arguments.push_back(currentConfigFile);
+	}
+	vector<char*> argv;
+	for (auto& argument : arguments)
+		argv.push_back(&argument[0]);
+	argv.push_back(nullptr);
+
+	LogDebug("Running: emitter LoadProfileByEmulator " + rom + " " + system);
+	pid_t pid;
+	int status = 0;
+	if (posix_spawnp(&pid, argv[0], nullptr, nullptr, argv.data(), environ) or waitpid(pid, &status, 0) == -1 or status != EXIT_SUCCESS)
+		LogWarning("Failed to execute emitter for " + rom);
 }
 
 #ifdef MiSTer
@@ -334,6 +373,26 @@ int main(int argc, char **argv) {
 		if (configValues.exists("logLevel"))
 			Log::setLogLevel(Log::str2level(configValues["logLevel"]));
 
+		// Connections, the resident emitter is optional.
+		if (configValues.exists("socket")) {
+			ledspicerd.socket = configValues["socket"];
+			if (configValues.exists("socketType"))
+				ledspicerd.socketType = Socks::str2type(configValues["socketType"]);
+		}
+		else if (configValues.exists("port")) {
+			ledspicerd.port = configValues["port"];
+		}
+		if (not ledspicerd.isSet())
+			throw Error("Missing port or socket attribute");
+		/*
+		 * The resident emitter only listens on its unix socket: connecting or sending fails at once when
+		 * nobody is listening, so the request falls back to a new emitter.
+		 */
+		if (configValues.exists(PARAM_EMITTER_SOCKET))
+			emitter.socket = configValues[PARAM_EMITTER_SOCKET];
+		if (emitter.isSet())
+			LogDebug("Using the resident emitter");
+
 		// Process main node.
 		tinyxml2::XMLElement* elementXML = config.getRoot()->FirstChildElement(NODE_MAIN_PROCESS);
 		if (not elementXML) throw Error("Missing configuration");
@@ -21,12 +21,18 @@
  */
 
 #include "utilities/XMLHelper.hpp"
+#include "client/Client.hpp"
 
 // for dirs
 #include <sys/types.h>
 #include <dirent.h>
 
+// To start emitter without a shell.
+#include <spawn.h>
+#include <sys/wait.h>
+
 using namespace LEDSpicer::Utilities;
+using LEDSpicer::Client;
 
 #define PROC_DIRECTORY    "/proc/"
 #define NODE_MAIN_PROCESS "processLookup"
@@ -37,6 +43,8 @@ using namespace LEDSpicer::Utilities;
 #define PARAM_PROCESS_POS  "position"
 #define PARAM_SYSTEM       "system"
 
+#define PARAM_EMITTER_SOCKET "emitterSocket"
+
 #define CMDLINE "/cmdline"
 
 #ifdef MiSTer
@@ -47,4 +55,36 @@ bool running = true;
 
 string currentConfigFile;
 
+/**
+ * Connection settings, connects on first use and again after a failure.
+ */
+struct Target {
+
+	string
+		port,
+		socket;
+
+	int socketType = SOCK_DGRAM;
+
+	std::unique_ptr<Client> client;
+
+	/**
+	 * @return true if the port or the socket are set.
+	 */
+	bool isSet() const {
+		return not port.empty() or not socket.empty();
+	}
+
+	/**
+	 * @return the connection or nullptr if it cannot be opened.
+	 */
+	Client* get();
+};
+
+/// Connection to ledspicerd.
+Target ledspicerd;
+
+/// Connection to a resident emitter, if configured, unix socket only.
+Target emitter;
+
 int main(int argc, char **argv);
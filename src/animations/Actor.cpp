@@ -36,6 +36,11 @@ Actor::Actor(
 	secondsToRestart(parameters.exists("restartTime") ? Utility::parseNumber(parameters["restartTime"], "Invalid Value for restart time") : 0),
 	// -1 = repeat forever, 0 never repeat, > 0 repeat times.
 	repeat(parameters.exists("repeat") ? Utility::parseNumber(parameters["repeat"], "Invalid Value for repeat") : 0),
+	generator(
+		parameters.exists("seed")
+			? static_cast<uint32_t>(Utility::parseNumber(parameters["seed"], "Invalid Value for seed"))
+			: RandomGenerator::getSeed(actorNumber)
+	),
 	affectedElements(group->size(), false),
 	group(group)
 {
@@ -82,7 +87,21 @@ void Actor::draw() {
 
 	// Reset Affected.
 	affectAllElements();
-	calculateElements();
+	if (bakedFrames.empty() or baking) {
+		calculateElements();
+		// Masking is done on replay.
+		if (baking) return;
+	}
+	else {
+		if (bakedFrame == bakedFrames.size() - 1)
+			bakedFrame = bakedLoop;
+		for (uint32_t c = bakedFrames[bakedFrame]; c < bakedFrames[bakedFrame + 1]; ++c) {
+			const BakedChange& change = bakedChanges[c];
+			affectedElements[change.index] = true;
+			group->getElement(change.index)->setColor(Color(change.r, change.g, change.b), change.filter, change.percent);
+		}
+		++bakedFrame;
+	}
 	// After effects.
 	if (not affectedElements.empty() and filter == Color::Filters::Mask) {
 		// turn off any non affected element.
@@ -116,6 +135,8 @@ void Actor::drawConfig() const {
 		cout << "Restart After:  " << std::fixed << std::setprecision(2) << secondsToRestart << " sec" << endl;
 	if (repeat)
 		cout << "Will repeat:    " << (repeat > 0 ? std::to_string(repeat) : "∞") << " times" << endl;
+	if (isBaked())
+		cout << "Baked:          " << (bakedFrames.size() - 1) << " frames, " << bakedChanges.size() << " changes" << endl;
 }
 
 void Actor::restart() {
@@ -132,6 +153,8 @@ void Actor::restart() {
 		restartTime = nullptr;
 	}
 
+	bakedFrame = 0;
+
 	if (secondsToStart) {
 		if (startTime) delete startTime;
 		startTime = new Time(secondsToStart);
@@ -243,6 +266,11 @@ void Actor::newFrame() {
 		Time::setFrameTime();
 	}
 	++frame;
+	++frameNumber;
+}
+
+uint32_t Actor::getFrameNumber() {
+	return frameNumber;
 }
 
 uint16_t Actor::getNumberOfElements() const {
@@ -251,6 +279,10 @@ uint16_t Actor::getNumberOfElements() const {
 
 void Actor::changeElementColor(uint16_t index, const Color& color, Color::Filters filter, uint8_t percent) {
 	affectedElements[index] = true;
+	if (baking) {
+		bakedChanges.push_back({index, color.getR(), color.getG(), color.getB(), filter, percent});
+		return;
+	}
 	Element* e = group->getElement(index);
 	e->setColor(color, filter, percent);
 }
@@ -270,6 +302,58 @@ const vector<uint8_t*>& Actor::getLeds() const {
 	return group->getLeds();
 }
 
+bool Actor::bake() {
+
+	uint32_t
+		warmup = getWarmupFrames(),
+		frames = getCycleFrames();
+
+	if (not frames) {
+		LogNotice("Actor " + to_string(actorNumber) + " is not deterministic, it cannot be baked");
+		return false;
+	}
+
+	bakedChanges.clear();
+	bakedFrames.clear();
+	bakedFrames.reserve(warmup + frames + 1);
+	restart();
+	baking = true;
+	for (uint32_t f = 0; f < warmup + frames; ++f) {
+		bakedFrames.push_back(bakedChanges.size());
+		draw();
+		if (bakedChanges.size() > BAKE_MAX_CHANGES)
+			break;
+	}
+	bakedFrames.push_back(bakedChanges.size());
+	baking = false;
+
+	if (bakedChanges.size() > BAKE_MAX_CHANGES) {
+		LogNotice("Actor " + to_string(actorNumber) + " cycle is too long to be baked");
+		bakedChanges  = {};
+		bakedFrames   = {};
+		restart();
+		return false;
+	}
+
+	bakedChanges.shrink_to_fit();
+	bakedLoop = warmup;
+	restart();
+	LogDebug("Actor " + to_string(actorNumber) + " baked " + to_string(warmup + frames) + " frames");
+	return true;
+}
+
+bool Actor::isBaked() const {
+	return not bakedFrames.empty();
+}
+
+uint32_t Actor::getCycleFrames() const {
+	return 0;
+}
+
+uint32_t Actor::getWarmupFrames() const {
+	return 0;
+}
+
 void Actor::affectAllElements(bool value) {
 	affectedElements.assign(group->size(), value);
 }
@@ -23,6 +23,7 @@
 #include "devices/Group.hpp"
 #include "utilities/Utility.hpp"
 #include "utilities/Time.hpp"
+#include "utilities/RandomGenerator.hpp"
 #include "utilities/Log.hpp"
 
 #pragma once
@@ -30,6 +31,9 @@
 /// Required parameters for Actor constructor.
 #define REQUIRED_PARAM_ACTOR {"type", "group", "filter"}
 
+/// Maximum number of element changes a baked actor can keep (8 bytes each).
+#define BAKE_MAX_CHANGES 1048576
+
 namespace LEDSpicer::Animations {
 
 using LEDSpicer::Devices::Group;
@@ -103,6 +107,11 @@ public:
 	 */
 	static void newFrame();
 
+	/**
+	 * @return the number of frames run, never resets.
+	 */
+	static uint32_t getFrameNumber();
+
 	/**
 	 * @return the number of elements on the animation's group.
 	 */
@@ -137,6 +146,20 @@ public:
 	 */
 	const vector<uint8_t*>& getLeds() const;
 
+	/**
+	 * Runs the actor for a whole cycle and keeps the element changes,
+	 * from there on draw replays them instead of calculating.
+	 * Element filters are still applied on replay, so the actor mixes with the others as before.
+	 *
+	 * @return false if the actor is not deterministic or the cycle is too long, it keeps calculating.
+	 */
+	bool bake();
+
+	/**
+	 * @return true if the actor replays a baked cycle.
+	 */
+	bool isBaked() const;
+
 protected:
 
 	inline static uint8_t
@@ -145,6 +168,9 @@ protected:
 		/// Current frame (starting from 1)
 		frame = 0;
 
+	/// Frames run since the start.
+	inline static uint32_t frameNumber = 0;
+
 	/// Keep truck of actors
 	const uint32_t actorNumber;
 
@@ -175,6 +201,9 @@ protected:
 	/// Times repeated.
 	uint16_t repeated = 0;
 
+	/// Random numbers for this actor, from the seed attribute or the global seed.
+	RandomGenerator generator;
+
 	/**
 	 * Do the elements calculation.
 	 *
@@ -197,8 +226,44 @@ protected:
 	 */
 	bool isElementAffected(uint16_t index) const;
 
+	/**
+	 * @return the number of system frames after which the actor repeats itself, zero if it never does.
+	 */
+	virtual uint32_t getCycleFrames() const;
+
+	/**
+	 * @return the number of system frames after a restart before the actor starts repeating itself.
+	 */
+	virtual uint32_t getWarmupFrames() const;
+
 private:
 
+	/// An element change made by a baked actor.
+	struct BakedChange {
+		uint16_t index;
+		uint8_t
+			r,
+			g,
+			b;
+		Color::Filters filter;
+		uint8_t percent;
+	};
+
+	/// Element changes of every baked frame, in order.
+	vector<BakedChange> bakedChanges;
+
+	/// Where every baked frame starts in bakedChanges, plus the end.
+	vector<uint32_t> bakedFrames;
+
+	uint32_t
+		/// Baked frame where the cycle starts again, after the warmup.
+		bakedLoop  = 0,
+		/// Next baked frame to replay.
+		bakedFrame = 0;
+
+	/// True while the cycle is being recorded.
+	bool baking = false;
+
 	/// Array with a list of affected elements.
 	vector<bool> affectedElements;
 
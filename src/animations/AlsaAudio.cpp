@@ -29,22 +29,44 @@ using LEDSpicer::Devices::Group;
 snd_pcm_t* AlsaAudio::pcm     = nullptr;
 uint8_t AlsaAudio::instances = 0;
 string AlsaAudio::pcmName;
+std::thread AlsaAudio::captureThread;
+std::atomic<bool> AlsaAudio::capturing {false};
 
 AlsaAudio::AlsaAudio(StringUMap& parameters, Group* const group) :
 	AudioActor(parameters, group) {
 
-	++instances;
-	if (pcm) return;
+	if (instances++) return;
 
 	if (pcmName.empty())
 		pcmName = parameters.exists("pcm") ? parameters["pcm"] : "default";
 
-	// Does not throw: calcPeak retries if the device is not ready or later drops.
-	connect();
+	// Does not throw: the thread retries if the device is not ready or later drops.
+	capturing.store(true);
+	captureThread = std::thread(capture);
 }
 
 AlsaAudio::~AlsaAudio() {
 	if (--instances) return;
+	capturing.store(false);
+	captureThread.join();
+	publishPeak(0, 0);
+}
+
+void AlsaAudio::capture() {
+
+	// Fresh audio matching the update rate, e.g., 48000/30 = 1600 samples.
+	const uint16_t samplesNeeded = SAMPLE_RATE / getFPS();
+	vector<int16_t> buffer(samplesNeeded * CHANNELS);
+
+	while (capturing.load()) {
+		if (pcm or connect()) {
+			read(buffer, samplesNeeded);
+			continue;
+		}
+		publishPeak(0, 0);
+		for (uint8_t c = 0; c < CAPTURE_RETRIES and capturing.load(); ++c)
+			std::this_thread::sleep_for(std::chrono::milliseconds(CAPTURE_WAIT));
+	}
 	disconnect();
 }
 
@@ -98,53 +120,44 @@ void AlsaAudio::disconnect() {
 	pcm = nullptr;
 }
 
-void AlsaAudio::calcPeak() {
-
-	// Reconnect after a device loss; skip the frame while unavailable.
-	if (not pcm and not connect()) return;
+void AlsaAudio::read(vector<int16_t>& buffer, uint16_t frames) {
 
-	// Calculate how many samples we need based on FPS
-	// This gives us "fresh" audio data matching our update rate
-	static const uint16_t samplesNeeded = (SAMPLE_RATE / getFPS()); // e.g., 48000/30 = 1600 samples
+	// Wait with a timeout so the thread can stop when the device goes quiet.
+	int ready = snd_pcm_wait(pcm, CAPTURE_WAIT);
+	if (ready == 0) return;
 
-	int16_t buffer[samplesNeeded * CHANNELS]; // *2 for stereo
-	snd_pcm_sframes_t frames = snd_pcm_readi(pcm, buffer, samplesNeeded);
+	snd_pcm_sframes_t read = ready < 0 ? ready : snd_pcm_readi(pcm, buffer.data(), frames);
 
 	// No new data
-	if (frames == -EAGAIN || frames == 0) return;
+	if (read == -EAGAIN or read == 0) return;
 
 	// Handle underruns quickly and silently (common in audio apps)
-	if (frames == -EPIPE) {
+	if (read == -EPIPE or read == -ESTRPIPE) {
 #ifdef DEVELOP
 		LogDebug("ALSA underrun, recovering");
 #endif
 		// Silent recovery
-		snd_pcm_recover(pcm, frames, 1);
+		snd_pcm_recover(pcm, read, 1);
 		return;
 	}
 
-	// Device gone: drop so the next frame reconnects.
-	if (frames < 0) {
-		LogWarning("ALSA error: " + string(snd_strerror(frames)) + ", reconnecting");
+	// Device gone: drop so the next loop reconnects.
+	if (read < 0) {
+		LogWarning("ALSA error: " + string(snd_strerror(read)) + ", reconnecting");
 		disconnect();
 		return;
 	}
 
-	// Reset peak values for this frame
-	value.l = value.r = 0;
+	if (Spectrum* s = spectrumInput.load(std::memory_order_acquire))
+		s->feed(buffer.data(), read, CHANNELS);
 
-	// Process actual samples received (frames * 2 for stereo)
-	uint16_t samples = frames * 2;
-	for (uint16_t c = 0; c < samples; ++c) {
-		float v = static_cast<float>(std::abs(buffer[c])) / MAX_AMP * 100.0f;
-		// Even indices = left, odd = right
-		if (c % CHANNELS) {
-			if (v > value.r) value.r = v;
-		}
-		else {
-			if (v > value.l) value.l = v;
-		}
-	}
+	// Process actual samples received.
+	AudioLevels::Levels levels = AudioLevels::measure(buffer.data(), read);
+	publishPeak(levels.peakL * 100.0f, levels.peakR * 100.0f);
+}
+
+void AlsaAudio::calcPeak() {
+	value = capturedPeak();
 }
 
 void AlsaAudio::drawConfig() const {
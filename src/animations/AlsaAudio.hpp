@@ -25,12 +25,18 @@
 #endif
 
 #include <alsa/asoundlib.h>
+#include <thread>
 #include "AudioActor.hpp"
 
 #pragma once
 
 constexpr uint16_t SAMPLE_RATE = 48000;
-constexpr float MAX_AMP        = 32767.0f;
+
+/// Milliseconds the capture thread waits for samples before checking if it has to stop.
+#define CAPTURE_WAIT 100
+
+/// Waits between attempts to open the capture device.
+#define CAPTURE_RETRIES 10
 
 namespace LEDSpicer::Animations {
 
@@ -39,6 +45,7 @@ using LEDSpicer::Utilities::Error;
 
 /**
  * LEDSpicer::Animations::AlsaAudio
+ * The device is read on its own thread, the actors only get the last peaks published.
  */
 class AlsaAudio: public AudioActor {
 
@@ -61,6 +68,24 @@ protected:
 	/// Capture device name, set by the first instance.
 	static string pcmName;
 
+	/// Reads the device.
+	static std::thread captureThread;
+
+	/// Cleared to stop the capture thread.
+	static std::atomic<bool> capturing;
+
+	/**
+	 * Capture thread loop, keeps the device open and publishes the peaks of every read.
+	 */
+	static void capture();
+
+	/**
+	 * Reads a block of samples.
+	 * @param buffer
+	 * @param frames block size.
+	 */
+	static void read(vector<int16_t>& buffer, uint16_t frames);
+
 	/**
 	 * Opens and starts the capture device.
 	 * @return true if the device is ready, false on any failure (left closed).
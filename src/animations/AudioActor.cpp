@@ -25,6 +25,11 @@
 using namespace LEDSpicer::Animations;
 
 AudioActor::Values AudioActor::value;
+std::atomic<uint32_t> AudioActor::captured {0};
+uint32_t AudioActor::analyzedFrame = UINT32_MAX;
+bool AudioActor::listening = false;
+std::unique_ptr<Spectrum> AudioActor::spectrum;
+std::atomic<Spectrum*> AudioActor::spectrumInput {nullptr};
 
 AudioActor::AudioActor(StringUMap& parameters, Group* const group) :
 	Actor(parameters, group, REQUIRED_PARAM_ACTOR_AUDIO),
@@ -60,6 +65,22 @@ AudioActor::AudioActor(StringUMap& parameters, Group* const group) :
 	case Modes::Wave:
 		colorData.insert(colorData.begin(), group->size(), Color::Off);
 		break;
+	case Modes::Spectrum: {
+		int
+			a = Utility::parseNumber(parameters.exists("attack") ? parameters["attack"] : DEFAULT_ATTACK, "Invalid attack"),
+			d = Utility::parseNumber(parameters.exists("decay")  ? parameters["decay"]  : DEFAULT_DECAY, "Invalid decay");
+		Utility::verifyValue<int>(a, 1, 100);
+		Utility::verifyValue<int>(d, 1, 100);
+		attack = a / 100.f;
+		decay  = d / 100.f;
+		levels.assign(group->size(), 0);
+		// The window is analyzed once for all the actors and kept for the next ones.
+		if (not spectrum) {
+			spectrum.reset(new Spectrum(SPECTRUM_SIZE, SPECTRUM_SAMPLE_RATE));
+			spectrumInput.store(spectrum.get(), std::memory_order_release);
+		}
+		break;
+	}
 	default: break;
 	}
 
@@ -76,6 +97,8 @@ AudioActor::AudioActor(StringUMap& parameters, Group* const group) :
 }
 
 void AudioActor::calculateElements() {
+	refreshPeak();
+	if (not listening) return;
 	switch (userPref.mode) {
 	case Modes::VuMeter:
 		vuMeters();
@@ -89,15 +112,61 @@ void AudioActor::calculateElements() {
 	case Modes::Disco:
 		disco();
 		break;
+	case Modes::Spectrum:
+		spectrumBands();
+		break;
 	}
 }
 
 void AudioActor::refreshPeak() {
+
+	// Every actor on the frame draws from the same analysis.
+	if (analyzedFrame == getFrameNumber())
+		return;
+	analyzedFrame = getFrameNumber();
+
+	value.l = value.r = 0;
+	// Recorded as the peaks followed by the listening flag.
+	char recorded[sizeof(value) + 1];
+	if (Recorder::isReplaying()) {
+		string data;
+		listening = Recorder::next(Recorder::Sources::Audio, data) and data.size() == sizeof(recorded);
+		if (listening) {
+			std::memcpy(&value, data.data(), sizeof(value));
+			listening = data.back();
+		}
+	}
+	else {
+		listening = isListening();
+		if (listening)
+			calcPeak();
+		std::memcpy(recorded, &value, sizeof(value));
+		recorded[sizeof(value)] = listening;
+		Recorder::record(Recorder::Sources::Audio, recorded, sizeof(recorded));
+	}
 #ifdef DEVELOP
 	displayPeak();
 #endif
-	value.l = value.r = 0;
-	calcPeak();
+}
+
+float AudioActor::getLevel() {
+	// Stale once no audio actor analyzes, like after changing to a profile without them.
+	if (not listening or analyzedFrame == UINT32_MAX or getFrameNumber() - analyzedFrame > 1)
+		return 0;
+	return std::max(value.l, value.r) / 100.f;
+}
+
+bool AudioActor::isListening() const {
+	return true;
+}
+
+void AudioActor::publishPeak(uint16_t l, uint16_t r) {
+	captured.store(l | static_cast<uint32_t>(r) << 16, std::memory_order_relaxed);
+}
+
+AudioActor::Values AudioActor::capturedPeak() {
+	uint32_t peaks = captured.load(std::memory_order_relaxed);
+	return {static_cast<uint16_t>(peaks & 0xFFFF), static_cast<uint16_t>(peaks >> 16)};
 }
 
 #ifdef DEVELOP
@@ -111,9 +180,6 @@ void AudioActor::displayPeak() {
 #endif
 
 void AudioActor::single() {
-
-	refreshPeak();
-
 	if (not value.l and not value.r) return;
 
 	// Left & Right.
@@ -165,7 +231,6 @@ void AudioActor::vuMeters() {
 		}
 	};
 
-	refreshPeak();
 	uint16_t val;
 	// TotalElements l or r have the total number of elements for solo channels.
 	// Convert to mono and them to elements.
@@ -246,8 +311,6 @@ void AudioActor::waves() {
 				colorData[c] = colorData[c + 1];
 	}
 
-	refreshPeak();
-
 	switch (userPref.channel) {
 	case Channels::Both:
 		if (direction == Directions::Forward) {
@@ -283,8 +346,6 @@ void AudioActor::disco() {
 		value.set(value.fade(80));
 	}
 
-	refreshPeak();
-
 	auto applySmoothing = [&](uint16_t idx, uint16_t totalSize, const Color& mainColor) {
 		// Apply main color to the primary index.
 		colorData[idx] = mainColor.transition(colorData[idx], 50);
@@ -355,6 +416,36 @@ void AudioActor::disco() {
 	}
 }
 
+void AudioActor::spectrumBands() {
+	uint16_t total = getNumberOfElements();
+	vector<float> recorded;
+	const vector<float>* bands = &recorded;
+	if (Recorder::isReplaying()) {
+		string data;
+		if (Recorder::next(Recorder::Sources::Audio, data) and data.size() == total * sizeof(float)) {
+			recorded.resize(total);
+			std::memcpy(recorded.data(), data.data(), data.size());
+		}
+		else {
+			recorded.assign(total, 0);
+		}
+	}
+	else {
+		bands = &spectrum->getBands(total);
+		Recorder::record(Recorder::Sources::Audio, bands->data(), total * sizeof(float));
+	}
+
+	for (uint16_t c = 0; c < total; ++c) {
+		float target = (*bands)[c];
+		levels[c] += (target - levels[c]) * (target > levels[c] ? attack : decay);
+		changeElementColor(
+			direction == Directions::Forward ? c : total - c - 1,
+			detectColor(std::lround(levels[c])),
+			filter
+		);
+	}
+}
+
 #define CALC_PERC(t, b) round(abs(percent - (b)) * 100.00 / ((t) - (b)))
 
 Color AudioActor::detectColor(uint8_t percent, bool gradient) {
@@ -399,6 +490,8 @@ Color AudioActor::getColorByPercent(const uint8_t percent) {
 
 void AudioActor::restart() {
 	value.l = value.r = 0;
+	analyzedFrame = UINT32_MAX;
+	std::fill(levels.begin(), levels.end(), 0);
 	Actor::restart();
 }
 
@@ -413,23 +506,29 @@ void AudioActor::drawConfig() const {
 		" Mid:  " << userPref.c50.getName() << endl <<
 		" High: " << userPref.c75.getName() << endl <<
 		"Direction: "   << (direction == Direction::Directions::Forward ? "Inward" : "Outward") << endl;
+	if (userPref.mode == Modes::Spectrum)
+		cout <<
+			"Attack: " << std::lround(attack * 100) << "%" << endl <<
+			"Decay:  " << std::lround(decay * 100)  << "%" << endl;
 }
 
 AudioActor::Modes AudioActor::str2mode(const string& mode) {
-	if (mode == "VuMeter") return Modes::VuMeter;
-	if (mode == "Single")  return Modes::Single;
-	if (mode == "Wave")    return Modes::Wave;
-	if (mode == "Disco")   return Modes::Disco;
+	if (mode == "VuMeter")  return Modes::VuMeter;
+	if (mode == "Single")   return Modes::Single;
+	if (mode == "Wave")     return Modes::Wave;
+	if (mode == "Disco")    return Modes::Disco;
+	if (mode == "Spectrum") return Modes::Spectrum;
 	LogError("Invalid mode " + mode + " assuming Single");
 	return Modes::Single;
 }
 
 string AudioActor::mode2str(Modes mode) {
 	switch (mode) {
-	case Modes::VuMeter: return "VuMeter";
-	case Modes::Single:  return "Single";
-	case Modes::Wave:    return "Wave";
-	case Modes::Disco:   return "Disco";
+	case Modes::VuMeter:  return "VuMeter";
+	case Modes::Single:   return "Single";
+	case Modes::Wave:     return "Wave";
+	case Modes::Disco:    return "Disco";
+	case Modes::Spectrum: return "Spectrum";
 	}
 	return "";
 }
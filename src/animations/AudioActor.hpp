@@ -21,6 +21,9 @@
  */
 
 #include "utilities/Direction.hpp"
+#include "utilities/Recorder.hpp"
+#include "utilities/Spectrum.hpp"
+#include "utilities/AudioLevels.hpp"
 #include "Actor.hpp"
 
 #pragma once
@@ -32,12 +35,23 @@
 #define MID_POINT 55
 #define LOW_POINT 25
 
+/// Samples analyzed by the spectrum.
+#define SPECTRUM_SIZE    2048
+/// Default percent a band moves toward a higher level every frame.
+#define DEFAULT_ATTACK   "70"
+/// Default percent a band moves toward a lower level every frame.
+#define DEFAULT_DECAY    "15"
+
 constexpr uint8_t CHANNELS = 2;
 
+/// Sample rate captured when a spectrum is used.
+constexpr uint32_t SPECTRUM_SAMPLE_RATE = 48000;
+
 namespace LEDSpicer::Animations {
 
 using LEDSpicer::Utilities::Direction;
 using LEDSpicer::Utilities::Error;
+using LEDSpicer::Utilities::AudioLevels;
 
 /**
  * LEDSpicer::Inputs::AudioActor
@@ -48,7 +62,7 @@ class AudioActor: public Actor, public Direction {
 
 public:
 
-	enum class Modes : uint8_t {VuMeter, Single, Wave, Disco};
+	enum class Modes : uint8_t {VuMeter, Single, Wave, Disco, Spectrum};
 
 	enum Channels : uint8_t {Left = 1, Right, Both, Mono};
 
@@ -70,6 +84,12 @@ public:
 
 	float getRunTime() const override;
 
+	/**
+	 * The analysis is done by the audio actors, so it is only valid on this frame or the previous one.
+	 * @return the loudest channel of the last analysis from 0 to 1, zero if nothing is listening or it is stale.
+	 */
+	static float getLevel();
+
 protected:
 
 	/// Peaks 0 to 100% but also used for number of elements per side
@@ -82,6 +102,15 @@ protected:
 	/// Preprocessed value.
 	static Values value;
 
+	/// Last peaks published by the capture thread, left on the low 16 bits and right on the high.
+	static std::atomic<uint32_t> captured;
+
+	/// Frame of the last analysis.
+	static uint32_t analyzedFrame;
+
+	/// True if the capture was running on the last analysis.
+	static bool listening;
+
 	/// Total elements per side, stereo or mono.
 	Values totalElements = {0, 0};
 
@@ -100,6 +129,20 @@ protected:
 	 */
 	vector<Color> colorData;
 
+	/// Spectrum shared by the actors in spectrum mode, created by the first one.
+	static std::unique_ptr<Spectrum> spectrum;
+
+	/// The spectrum as seen by the capture threads, set once it is ready.
+	static std::atomic<Spectrum*> spectrumInput;
+
+	/// Smoothed level of every element in spectrum mode.
+	vector<float> levels;
+
+	/// Spectrum smoothing, percent moved every frame.
+	float
+		attack = 0,
+		decay  = 0;
+
 	/**
 	 * Detects the color based on the percent.
 	 * @param percent
@@ -118,15 +161,32 @@ protected:
 	void calculateElements() override;
 
 	/**
-	 * Refresh the peak information (calls calcPeak).
+	 * Refresh the peak information (calls calcPeak), once per frame for all the actors.
 	 */
 	void refreshPeak();
 
+	/**
+	 * @return true if the capture is running, nothing is drawn otherwise.
+	 */
+	virtual bool isListening() const;
+
 	/**
 	 * Calculates the peak out of raw data in percentage (0 to 100).
 	 */
 	virtual void calcPeak() = 0;
 
+	/**
+	 * Publishes the peaks of the last samples captured, called from the capture thread.
+	 * @param l left peak, 0 to 100.
+	 * @param r right peak, 0 to 100.
+	 */
+	static void publishPeak(uint16_t l, uint16_t r);
+
+	/**
+	 * @return the last peaks published by the capture thread.
+	 */
+	static Values capturedPeak();
+
 #ifdef DEVELOP
 	/**
 	 * for debug.
@@ -154,6 +214,11 @@ protected:
 	 */
 	void disco();
 
+	/**
+	 * Calculates a spectrum analyzer, one band per element from low to high.
+	 */
+	void spectrumBands();
+
 };
 
 } // namespace
@@ -25,42 +25,51 @@
 
 using namespace LEDSpicer::Animations;
 
-stringMatrixColorsUmap FileReader::fileData;
+stringAnimationUmap FileReader::fileData;
+unordered_map<string, std::unique_ptr<AnimationFile>> FileReader::animations;
 
 FileReader::FileReader(StringUMap& parameters, Group* const group) :
 	DirectionActor(parameters, group, REQUIRED_PARAM_ACTOR_FILEREADER)
 {
+	if (str2Format(parameters["format"]) == Formats::binary) {
+		processBinary(parameters["filename"]);
+		stepping.frames = animation->getFrames();
+		stepping.steps  = calculateStepsBySpeed(speed);
+		return;
+	}
 	auto found = fileData.find(parameters["filename"]);
 	if (found == fileData.end()) {
-		switch(str2Format(parameters["format"])) {
-		case Formats::rgba:
-			processRGBA(parameters["filename"]);
-			break;
-		}
+		processRGBA(parameters["filename"]);
 	}
 	else{
 		LogDebug("File " + parameters["filename"] + " already in memory");
 		frames = found;
 	}
-	stepping.frames = frames->second.size();
+	rgb.resize(frames->second.getElements() * KeyframeAnimation::CHANNELS);
+	stepping.frames = frames->second.getFrames();
 	stepping.steps  = calculateStepsBySpeed(speed);
 }
 
 void FileReader::drawConfig() const {
 	cout << "FileReader" << endl;
 	DirectionActor::drawConfig();
-	cout << "File: " << frames->first << endl;
+	if (animation)
+		cout << "File: " << animation->getFilename() << " (binary)" << endl;
+	else
+		cout << "File: " << frames->first << endl;
 }
 
 string FileReader::Format2str(const Formats format) {
 	switch (format) {
-	case Formats::rgba: return "rgba";
+	case Formats::rgba:   return "rgba";
+	case Formats::binary: return "binary";
 	default: return "";
 	}
 }
 
 FileReader::Formats FileReader::str2Format(const string& format) {
-	if (format == "rgba") return Formats::rgba;
+	if (format == "rgba")   return Formats::rgba;
+	if (format == "binary") return Formats::binary;
 	throw Error("Invalid type ") << format;
 }
 
@@ -69,7 +78,7 @@ void FileReader::processRGBA(const string& filename) {
 	StringUMap fileAttr = file.processNode(file.getRoot());
 	tinyxml2::XMLElement * element = file.getRoot()->FirstChildElement("frm");
 	if (not element) throw Error("No frames found for " + filename);
-	vector<vector<Color>> framesTmp;
+	KeyframeAnimation keyframes;
 	for (; element; element = element->NextSiblingElement("frm")) {
 		StringUMap frameData = file.processNode(element);
 		Utility::checkAttributes({"dec"}, frameData, "frm");
@@ -87,7 +96,7 @@ void FileReader::processRGBA(const string& filename) {
 			LogWarning("More colors than element colors detected");
 		}
 #endif
-		vector<Color> frameTmp;
+		vector<uint8_t> frameTmp;
 		Color colorTmp;
 		for (uint16_t c = 0; c < colorData.size();) {
 			for (uint8_t c2 = 0; c2 < 3; ++c2, ++c) {
@@ -105,26 +114,50 @@ void FileReader::processRGBA(const string& filename) {
 					break;
 				}
 			}
-			frameTmp.push_back(std::move(colorTmp));
-			if (frameTmp.size() == getNumberOfElements()) break;
+			frameTmp.insert(frameTmp.end(), {colorTmp.getR(), colorTmp.getG(), colorTmp.getB()});
+			if (frameTmp.size() == getNumberOfElements() * KeyframeAnimation::CHANNELS) break;
 		}
-		frameTmp.shrink_to_fit();
-		framesTmp.push_back(std::move(frameTmp));
+		keyframes.add(frameTmp);
 	}
-	fileData.emplace(filename, framesTmp);
-	frames = fileData.find(filename);
+	if (not keyframes.getFrames()) throw Error("No frames found for " + filename);
+	keyframes.shrink();
+	LogDebug(
+		"File " + filename + " uses " + to_string(keyframes.getMemory()) + " bytes for " +
+		to_string(keyframes.getFrames()) + " frames"
+	);
+	frames = fileData.emplace(filename, std::move(keyframes)).first;
+}
+
+void FileReader::processBinary(const string& filename) {
+	auto found = animations.find(filename);
+	if (found == animations.end())
+		found = animations.emplace(filename, std::make_unique<AnimationFile>(filename)).first;
+	else
+		LogDebug("File " + filename + " already in memory");
+	animation = found->second.get();
+	rgb.resize(animation->getElements() * AnimationFile::CHANNELS);
 }
 
 void FileReader::calculateElements() {
 #ifdef DEVELOP
 	cout << "FileReader: " << DrawDirection(getDirection()) << " F: " << (stepping.frame + 1) << endl;
 #endif
-	for (uint16_t c = 0; c < frames->second[stepping.frame].size(); ++c) {
+	if (animation) {
+		uint16_t count = std::min(animation->decode(stepping.frame, rgb.data()), getNumberOfElements());
+		for (uint16_t c = 0; c < count; ++c) {
+			const uint8_t* color = &rgb[c * AnimationFile::CHANNELS];
+			changeElementColor(c, Color(color[0], color[1], color[2]), filter);
+		}
+		return;
+	}
+	uint16_t count = frames->second.decode(stepping.frame, rgb.data(), decoded);
+	for (uint16_t c = 0; c < count; ++c) {
+		const uint8_t* color = &rgb[c * KeyframeAnimation::CHANNELS];
 #ifdef DEVELOP
 		cout << "element: " <<  to_string(c)  << " -> ";
-		frames->second[stepping.frame].at(c).drawHex();
+		Color(color[0], color[1], color[2]).drawHex();
 		cout << endl;
 #endif
-		changeElementColor(c, frames->second[stepping.frame].at(c), filter);
+		changeElementColor(c, Color(color[0], color[1], color[2]), filter);
 	}
 }
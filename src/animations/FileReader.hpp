@@ -20,13 +20,15 @@
  * with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "utilities/AnimationFile.hpp"
+#include "utilities/KeyframeAnimation.hpp"
 #include "DirectionActor.hpp"
 
 #pragma once
 
 #define REQUIRED_PARAM_ACTOR_FILEREADER {"speed", "direction", "filename", "format"}
 
-using stringMatrixColorsUmap = unordered_map<string, vector<vector<LEDSpicer::Utilities::Color>>>;
+using stringAnimationUmap = unordered_map<string, LEDSpicer::Utilities::KeyframeAnimation>;
 
 namespace LEDSpicer::Animations {
 
@@ -37,7 +39,7 @@ class FileReader : public DirectionActor {
 
 public:
 
-	enum class Formats : uint8_t {rgba};
+	enum class Formats : uint8_t {rgba, binary};
 
 	FileReader(StringUMap& parameters, Group* const layout);
 
@@ -56,10 +58,22 @@ protected:
 private:
 
 	/// Iterator to the pair
-	stringMatrixColorsUmap::iterator frames;
+	stringAnimationUmap::iterator frames;
 
 	/// All files on memory data by filename.
-	static stringMatrixColorsUmap fileData;
+	static stringAnimationUmap fileData;
+
+	/// Frame of the file on rgb.
+	uint32_t decoded = KeyframeAnimation::NO_FRAME;
+
+	/// Binary animations mapped by filename.
+	static unordered_map<string, std::unique_ptr<AnimationFile>> animations;
+
+	/// Binary animation in use, or null for the other formats.
+	const AnimationFile* animation = nullptr;
+
+	/// Decoded frame.
+	vector<uint8_t> rgb;
 
 	/**
 	 * Loads into memory a RGBA file, an animation file that stores data in RGB values divided into frames.
@@ -67,6 +81,12 @@ private:
 	 */
 	void processRGBA(const string& filename);
 
+	/**
+	 * Maps a binary animation file, frames are decoded when drawn.
+	 * @param filename
+	 */
+	void processBinary(const string& filename);
+
 };
 
 } // namespace
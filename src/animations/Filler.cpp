@@ -61,7 +61,7 @@ void Filler::generateNextRandom() {
 		return;
 	else if (possibleElements.size() > 1)
 		// Roll dice.
-		currentRandom = possibleElements[std::rand() / ((RAND_MAX + 1u) / (possibleElements.size() - 1))];
+		currentRandom = possibleElements[generator.below(possibleElements.size())];
 	else
 		// only one left
 		currentRandom = possibleElements[0];
@@ -108,6 +108,13 @@ void Filler::calculateElements() {
 	if (not stepping.frame and not stepping.step and not isBouncing()) advanceColor();
 }
 
+uint32_t Filler::getCycleFrames() const {
+	// Random picks the elements on the run.
+	if (mode == Modes::Random)
+		return 0;
+	return getFullFrames() * colors.size();
+}
+
 void Filler::fillElementsLinear() {
 
 	const Color* color(colors[currentColor]);
@@ -56,6 +56,11 @@ protected:
 
 	void calculateElements() override;
 
+	/**
+	 * @see Actor::getCycleFrames()
+	 */
+	uint32_t getCycleFrames() const override;
+
 private:
 
 	/// Stores the mode.
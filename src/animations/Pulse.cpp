@@ -52,6 +52,10 @@ void Pulse::calculateElements() {
 	if (isEndOfCycle()) advanceColor();
 }
 
+uint32_t Pulse::getCycleFrames() const {
+	return getFullFrames() * colors.size();
+}
+
 void Pulse::drawConfig() const {
 	cout << "Pulse" << endl;
 	DirectionActor::drawConfig();
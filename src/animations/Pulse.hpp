@@ -54,6 +54,11 @@ protected:
 
 	void calculateElements() override;
 
+	/**
+	 * @see Actor::getCycleFrames()
+	 */
+	uint32_t getCycleFrames() const override;
+
 private:
 
 	const Modes mode;
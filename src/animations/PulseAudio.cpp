@@ -32,7 +32,7 @@ string PulseAudio::source;
 std::mutex PulseAudio::mutex;
 std::atomic<PulseAudio::State> PulseAudio::state{State::Disconnected};
 
-vector<uint8_t> PulseAudio::rawData;
+std::atomic<bool> PulseAudio::fullRate {false};
 
 PulseAudio::PulseAudio(StringUMap& parameters, Group* const group) :
 	AudioActor(parameters, group)
@@ -41,6 +41,13 @@ PulseAudio::PulseAudio(StringUMap& parameters, Group* const group) :
 
 	LogInfo("Connecting to PulseAudio");
 
+	// A stream reading only the peaks cannot feed the spectrum.
+	if (spectrum and not fullRate.load() and state.load() == State::Connected) {
+		LogInfo("Reconnecting PulseAudio to capture the spectrum");
+		disconnect();
+		state.store(State::Disconnected);
+	}
+
 	// If already connected or connecting, reuse.
 	if (state.load() != State::Disconnected) {
 		LogInfo("Reusing PulseAudio connection");
@@ -122,6 +129,7 @@ void PulseAudio::disconnect() {
 		pa_threaded_mainloop_free(tml);
 		tml = nullptr;
 	}
+	publishPeak(0, 0);
 }
 
 void PulseAudio::scheduleReconnect() {
@@ -248,7 +256,10 @@ void PulseAudio::onSinkInfo(pa_context* context, const pa_sink_info* info, int e
 	LogDebug("Sample Size: " + to_string(pa_sample_size(&info->sample_spec)));
 #endif
 
-	pa_sample_spec ss = {SAMPLE_FORMAT, RATE, CHANNELS};
+	// The spectrum needs every sample, the rest only the peaks.
+	bool full = spectrumInput.load(std::memory_order_acquire) != nullptr;
+	fullRate.store(full);
+	pa_sample_spec ss = {SAMPLE_FORMAT, full ? SPECTRUM_SAMPLE_RATE : RATE, CHANNELS};
 
 	stream = pa_stream_new(context, STREAM_NAME, &ss, &info->channel_map);
 	if (not stream) {
@@ -278,9 +289,10 @@ void PulseAudio::onSinkInfo(pa_context* context, const pa_sink_info* info, int e
 
 	pa_buffer_attr ba;
 	ba.maxlength = -1;
-	ba.fragsize  = sizeof(float) * CHANNELS;
+	// Full rate streams deliver a frame worth of samples at once.
+	ba.fragsize  = sizeof(float) * CHANNELS * (full ? SPECTRUM_SAMPLE_RATE / getFPS() : 1);
 	ba.prebuf    = 0;
-	if (pa_stream_connect_record(stream, info->monitor_source_name, &ba, PA_STREAM_PEAK_DETECT) < 0) {
+	if (pa_stream_connect_record(stream, info->monitor_source_name, &ba, full ? PA_STREAM_NOFLAGS : PA_STREAM_PEAK_DETECT) < 0) {
 		LogWarning("Failed to connect to output stream: " + string(pa_strerror(pa_context_errno(context))));
 		scheduleReconnect();
 	}
@@ -318,8 +330,6 @@ void PulseAudio::onStreamSetState(pa_stream* stream, void* userdata) {
 
 void PulseAudio::onStreamRead(pa_stream* stream, size_t length, void* userdata) {
 
-	std::lock_guard<std::mutex> lock(mutex);
-	rawData.clear();
 	if (not length) return;
 
 	// Read peaks.
@@ -339,33 +349,23 @@ void PulseAudio::onStreamRead(pa_stream* stream, size_t length, void* userdata)
 	const float* buffer = static_cast<const float*>(data);
 	size_t samples = length / sizeof(float);
 
-	for (size_t i = 0; i < samples; ++i) {
-		float v = fabsf(buffer[i]);
-		if (v > 1.0f) v = 1.0f;
-		rawData.push_back(roundf(v * 100.f));
-	}
+	Spectrum* s = spectrumInput.load(std::memory_order_acquire);
+	if (s and fullRate.load())
+		s->feed(buffer, samples / CHANNELS, CHANNELS);
+
+	AudioLevels::Levels levels = AudioLevels::measure(buffer, samples / CHANNELS);
 	pa_stream_drop(stream);
+	publishPeak(
+		roundf(std::min(levels.peakL, 1.0f) * 100.f),
+		roundf(std::min(levels.peakR, 1.0f) * 100.f)
+	);
 }
 
-void PulseAudio::calculateElements() {
+bool PulseAudio::isListening() const {
 	// Skip processing if not connected.
-	if (state.load() != State::Connected) return;
-
-	std::lock_guard<std::mutex> lock(mutex);
-	AudioActor::calculateElements();
+	return state.load() == State::Connected;
 }
 
 void PulseAudio::calcPeak() {
-	auto size(rawData.size());
-	value.l = value.r = 0;
-	for (size_t c = 0; c < size; ++c) {
-		uint8_t v = rawData[c];
-		// Even for left, odd for right.
-		if (c % CHANNELS) {
-			if (v > value.r) value.r = v;
-		}
-		else {
-			if (v > value.l) value.l = v;
-		}
-	}
+	value = capturedPeak();
 }
@@ -41,6 +41,7 @@ namespace LEDSpicer::Animations {
 /**
  * LEDSpicer::Animations::PulseAudio
  * Pulseaudio output plugin.
+ * The samples arrive on the PulseAudio thread, the actors only get the last peaks published.
  */
 class PulseAudio: public AudioActor {
 
@@ -62,11 +63,11 @@ protected:
 
 	static string source;
 
-	/// To avoid updating when is reading the buffer.
+	/// Serializes the shutdown of the last instance.
 	static std::mutex mutex;
 
-	/// Raw peak data.
-	static vector<uint8_t> rawData;
+	/// True if the stream captures every sample instead of the peaks, used by the spectrum.
+	static std::atomic<bool> fullRate;
 
 	/// Connection state.
 	enum class State : uint8_t {
@@ -128,7 +129,7 @@ protected:
 
 	void calcPeak() override;
 
-	void calculateElements() override;
+	bool isListening() const override;
 
 };
 
@@ -54,7 +54,7 @@ void Random::calculateElements() {
 void Random::generateNewColors() {
 	newColors.clear();
 	for (uint16_t c = 0; c < getNumberOfElements(); ++c)
-		newColors.push_back(colors[std::rand() / ((RAND_MAX + 1u) / colors.size())]);
+		newColors.push_back(colors[generator.below(colors.size())]);
 }
 
 void Random::drawConfig() const {
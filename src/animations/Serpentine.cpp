@@ -134,6 +134,15 @@ void Serpentine::calculateElements() {
 	}
 }
 
+uint32_t Serpentine::getCycleFrames() const {
+	return getFullFrames();
+}
+
+uint32_t Serpentine::getWarmupFrames() const {
+	// The tail starts piled up on the first element, after a cycle it is always behind.
+	return tailData.empty() ? 0 : getFullFrames();
+}
+
 void Serpentine::calculateTailPosition() {
 	// only calculate on new frames.
 	if (stepping.step) return;
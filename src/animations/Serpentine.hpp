@@ -50,6 +50,16 @@ protected:
 
 	void calculateElements() override;
 
+	/**
+	 * @see Actor::getCycleFrames()
+	 */
+	uint32_t getCycleFrames() const override;
+
+	/**
+	 * @see Actor::getWarmupFrames()
+	 */
+	uint32_t getWarmupFrames() const override;
+
 private:
 
 	const Color& tailColor;
@@ -0,0 +1,73 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      Shader.cpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "Shader.hpp"
+#include "AudioActor.hpp"
+
+using namespace LEDSpicer::Animations;
+
+Shader::Shader(StringUMap& parameters, Group* const group) :
+	Actor(parameters, group, REQUIRED_PARAM_ACTOR_SHADER),
+	Colors(parameters.exists("colors") ? parameters["colors"] : Color_On),
+	expression(parameters["expression"], generator.next()),
+	values(group->size())
+{}
+
+void Shader::calculateElements() {
+
+	expression.evaluate({static_cast<float>(frames) / FPS, static_cast<float>(frames), AudioActor::getLevel()}, values);
+	++frames;
+
+	const uint8_t last = colors.size() - 1;
+	for (uint16_t c = 0; c < values.size(); ++c) {
+		// Out of range and invalid results are clamped.
+		float value = values[c] > 0 ? std::fmin(values[c], 1.f) : 0;
+		if (not last) {
+			changeElementColor(c, colors[0]->fade(value * 100), filter);
+			continue;
+		}
+		float position = value * last;
+		uint8_t from = std::min<uint8_t>(position, last - 1);
+		changeElementColor(c, colors[from]->transition(*colors[from + 1], (position - from) * 100), filter);
+	}
+#ifdef DEVELOP
+	if (Log::isLogging(LOG_DEBUG)) {
+		cout << "Shader: Frame " << frames << " Time " << std::fixed << std::setprecision(2) << (static_cast<float>(frames) / FPS) << endl;
+	}
+#endif
+}
+
+void Shader::drawConfig() const {
+	cout << "Shader" << endl;
+	Actor::drawConfig();
+	cout <<
+		"Expression: " << expression.getSource() << " (" << expression.getSize() << " instructions)" << endl <<
+		"Colors:     ";
+	this->drawColors();
+	cout << endl;
+}
+
+void Shader::restart() {
+	Actor::restart();
+	frames = 0;
+}
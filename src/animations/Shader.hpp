@@ -0,0 +1,69 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      Shader.hpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "utilities/Colors.hpp"
+#include "utilities/Expression.hpp"
+#include "Actor.hpp"
+
+#pragma once
+
+#define REQUIRED_PARAM_ACTOR_SHADER {"expression"}
+
+namespace LEDSpicer::Animations {
+
+using LEDSpicer::Utilities::Expression;
+
+/**
+ * LEDSpicer::Animations::Shader
+ *
+ * Paints every element with the result of an expression from 0 to 1, see Expression for the language.
+ * With one color the result fades it, with more colors it moves along them like a gradient.
+ * The time, the frame and the audio level of the audio actors on the profile are set every frame.
+ */
+class Shader: public Actor, public Colors {
+
+public:
+
+	Shader(StringUMap& parameters, Group* const group);
+
+	virtual ~Shader() = default;
+
+	void drawConfig() const override;
+
+	void restart() override;
+
+protected:
+
+	/// The compiled expression.
+	Expression expression;
+
+	/// Result for every element.
+	vector<float> values;
+
+	/// Frames since the restart.
+	uint32_t frames = 0;
+
+	void calculateElements() override;
+};
+
+} // namespace
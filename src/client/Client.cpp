@@ -0,0 +1,138 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      Client.cpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Client.hpp"
+#include "ledspicer-client.h"
+
+using namespace LEDSpicer;
+using namespace LEDSpicer::Utilities;
+
+Client::Client(const string& port, const string& path, int sockType) : socks(LOCALHOST, path.empty() ? port : "") {
+	if (not path.empty())
+		socks.prepareUnix(path, false, sockType);
+}
+
+bool Client::isConnected() {
+	return socks.isConnected();
+}
+
+bool Client::send(const Message& msg, bool binary) {
+	return socks.send(binary ? msg.toBinary() : msg.toString());
+}
+
+bool Client::loadProfile(const vector<string>& profiles, uint8_t flags) {
+	return sendRequest(Message::Types::LoadProfile, profiles, flags);
+}
+
+bool Client::loadProfileByEmulator(const string& rom, const string& system, uint8_t flags) {
+	return sendRequest(Message::Types::LoadProfileByEmulator, {rom, system}, flags);
+}
+
+bool Client::finishLastProfile(uint8_t flags) {
+	return sendRequest(Message::Types::FinishLastProfile, {}, flags);
+}
+
+bool Client::finishAllProfiles() {
+	return sendRequest(Message::Types::FinishAllProfiles, {});
+}
+
+bool Client::setElement(const string& element, const string& color, const string& filter) {
+	return sendRequest(Message::Types::SetElement, {element, color, filter});
+}
+
+bool Client::clearElement(const string& element) {
+	return sendRequest(Message::Types::ClearElement, {element});
+}
+
+bool Client::setGroup(const string& group, const string& color, const string& filter) {
+	return sendRequest(Message::Types::SetGroup, {group, color, filter});
+}
+
+bool Client::clearGroup(const string& group) {
+	return sendRequest(Message::Types::ClearGroup, {group});
+}
+
+bool Client::sendRequest(Message::Types type, const vector<string>& data, uint8_t flags) {
+	Message msg(type);
+	msg.setFlags(flags);
+	for (auto& d : data)
+		msg.addData(d);
+	return send(msg);
+}
+
+/* C interface */
+
+struct ledspicer_client : public Client {
+	using Client::Client;
+};
+
+ledspicer_client* ledspicer_client_open(const char* port, const char* path, int seqpacket) {
+	try {
+		return new ledspicer_client(
+			port ? port : "",
+			path ? path : "",
+			seqpacket ? SOCK_SEQPACKET : SOCK_DGRAM
+		);
+	}
+	catch (Error& e) {
+		LogError(e.getMessage());
+		return nullptr;
+	}
+}
+
+void ledspicer_client_close(ledspicer_client* client) {
+	delete client;
+}
+
+int ledspicer_client_type(const char* name) {
+	try {
+		return static_cast<int>(Message::str2type(name ? name : ""));
+	}
+	catch (Error& e) {
+		return -1;
+	}
+}
+
+uint8_t ledspicer_client_flags(const char* flags) {
+	uint8_t result = 0;
+	Message::str2flag(result, flags ? flags : "");
+	return result;
+}
+
+int ledspicer_client_send(ledspicer_client* client, int type, uint8_t flags, const char* const* data, size_t count) {
+	if (not client or type < 0) return 0;
+	Message msg(static_cast<Message::Types>(type));
+	msg.setFlags(flags);
+	for (size_t c = 0; c < count; ++c)
+		msg.addData(data[c] ? data[c] : "");
+	return client->send(msg);
+}
+
+int ledspicer_client_load_profile_by_emulator(ledspicer_client* client, const char* rom, const char* system, uint8_t flags) {
+	if (not client or not rom or not system) return 0;
+	return client->loadProfileByEmulator(rom, system, flags);
+}
+
+int ledspicer_client_finish_last_profile(ledspicer_client* client, uint8_t flags) {
+	if (not client) return 0;
+	return client->finishLastProfile(flags);
+}
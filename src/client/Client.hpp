@@ -0,0 +1,144 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      Client.hpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utilities/Socks.hpp"
+#include "utilities/Message.hpp"
+
+#pragma once
+
+namespace LEDSpicer {
+
+using Utilities::Message;
+using Utilities::Socks;
+
+/**
+ * LEDSpicer::Client
+ *
+ * Keeps a connection to ledspicerd (or to a resident emitter) and sends requests over it,
+ * so frontends and tools do not need to start a new emitter process for every request.
+ */
+class Client {
+
+public:
+
+	/**
+	 * Connects to a UDP port on localhost or to a unix domain socket.
+	 * @param port the UDP port, ignored when a socket file is provided.
+	 * @param path the unix socket file, empty to use the port.
+	 * @param sockType SOCK_DGRAM or SOCK_SEQPACKET.
+	 * @throws Error if the connection cannot be created.
+	 */
+	Client(const string& port, const string& path = "", int sockType = SOCK_DGRAM);
+
+	virtual ~Client() = default;
+
+	/**
+	 * @return true if the connection is ready.
+	 */
+	bool isConnected();
+
+	/**
+	 * Sends a message.
+	 * @param msg
+	 * @param binary true to use the binary protocol.
+	 * @return true on success.
+	 */
+	bool send(const Message& msg, bool binary = false);
+
+	/**
+	 * Requests the first valid profile from a list.
+	 * @param profiles
+	 * @param flags
+	 * @return true on success.
+	 */
+	bool loadProfile(const vector<string>& profiles, uint8_t flags = 0);
+
+	/**
+	 * Requests a profile for a game, needs a resident emitter to resolve the game data.
+	 * @param rom
+	 * @param system
+	 * @param flags
+	 * @return true on success.
+	 */
+	bool loadProfileByEmulator(const string& rom, const string& system, uint8_t flags = 0);
+
+	/**
+	 * Terminates the current profile.
+	 * @param flags
+	 * @return true on success.
+	 */
+	bool finishLastProfile(uint8_t flags = 0);
+
+	/**
+	 * Terminates every profile.
+	 * @return true on success.
+	 */
+	bool finishAllProfiles();
+
+	/**
+	 * Changes an element background color.
+	 * @param element
+	 * @param color
+	 * @param filter
+	 * @return true on success.
+	 */
+	bool setElement(const string& element, const string& color, const string& filter = "Normal");
+
+	/**
+	 * Removes an element background color.
+	 * @param element
+	 * @return true on success.
+	 */
+	bool clearElement(const string& element);
+
+	/**
+	 * Changes a group background color.
+	 * @param group
+	 * @param color
+	 * @param filter
+	 * @return true on success.
+	 */
+	bool setGroup(const string& group, const string& color, const string& filter = "Normal");
+
+	/**
+	 * Removes a group background color.
+	 * @param group
+	 * @return true on success.
+	 */
+	bool clearGroup(const string& group);
+
+protected:
+
+	Socks socks;
+
+	/**
+	 * Sends a message built from a type and its data.
+	 * @param type
+	 * @param data
+	 * @param flags
+	 * @return true on success.
+	 */
+	bool sendRequest(Message::Types type, const vector<string>& data, uint8_t flags = 0);
+
+};
+
+} // namespace
@@ -0,0 +1,95 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      ledspicer-client.h
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#pragma once
+
+/**
+ * C interface for the LEDSpicer client library.
+ * Functions returning int return 1 on success and 0 on failure.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Opaque connection handler.
+typedef struct ledspicer_client ledspicer_client;
+
+/**
+ * Connects to ledspicerd or to a resident emitter.
+ * @param port UDP port on localhost, ignored when path is set.
+ * @param path unix socket file or NULL to use the port.
+ * @param seqpacket non zero to use SOCK_SEQPACKET on the unix socket.
+ * @return the connection or NULL on error.
+ */
+ledspicer_client* ledspicer_client_open(const char* port, const char* path, int seqpacket);
+
+/**
+ * Closes and releases a connection.
+ * @param client
+ */
+void ledspicer_client_close(ledspicer_client* client);
+
+/**
+ * @param name message type name, like LoadProfile or SetElement.
+ * @return the message type or -1 if the name is unknown.
+ */
+int ledspicer_client_type(const char* name);
+
+/**
+ * @param flags pipe separated flag names, like "NO_ANIMATIONS|REPLACE".
+ * @return the flags value.
+ */
+uint8_t ledspicer_client_flags(const char* flags);
+
+/**
+ * Sends a message.
+ * @param client
+ * @param type message type, see ledspicer_client_type.
+ * @param flags
+ * @param data message fields.
+ * @param count number of fields.
+ */
+int ledspicer_client_send(ledspicer_client* client, int type, uint8_t flags, const char* const* data, size_t count);
+
+/**
+ * Requests a profile for a game, needs a resident emitter.
+ * @param client
+ * @param rom
+ * @param system
+ * @param flags
+ */
+int ledspicer_client_load_profile_by_emulator(ledspicer_client* client, const char* rom, const char* system, uint8_t flags);
+
+/**
+ * Terminates the current profile.
+ * @param client
+ * @param flags
+ */
+int ledspicer_client_finish_last_profile(ledspicer_client* client, uint8_t flags);
+
+#ifdef __cplusplus
+}
+#endif
@@ -143,10 +143,38 @@ void Device::packData() {
 #endif
 		return;
 	}
+	// Rate limited devices keep the changes until the interval is over.
+	if (maxRefresh) {
+		auto now = high_resolution_clock::now();
+		if (now - lastTransfer < refreshInterval) {
+#ifdef SHOW_OUTPUT
+			LogDebug("Refresh interval not reached, data postponed for " + getFullName());
+#endif
+			return;
+		}
+		lastTransfer = now;
+	}
 	transfer();
 	oldLEDs = LEDs;
 }
 
+void Device::setMaxRefresh(uint8_t hz) {
+	maxRefresh      = hz;
+	refreshInterval = milliseconds(hz ? 1000 / hz : 0);
+}
+
+uint8_t Device::getMaxRefresh() const {
+	return maxRefresh;
+}
+
+void Device::setConcurrentTransfer(bool concurrent) {
+	concurrentTransfer = concurrent;
+}
+
+bool Device::isConcurrentTransfer() const {
+	return concurrentTransfer;
+}
+
 ElementUMap* Device::getElements() {
 	return &elementsByName;
 }
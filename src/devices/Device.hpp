@@ -181,9 +181,33 @@ public:
 
 	/**
 	 * Pack the data into the device.
+	 * If the device has a maximum refresh rate, the transfer is postponed until the
+	 * interval has elapsed, the latest LEDs state will be sent then.
 	 */
 	virtual void packData();
 
+	/**
+	 * Sets the maximum number of transfers per second for this device.
+	 * @param hz 0 to transfer at the global frame rate.
+	 */
+	void setMaxRefresh(uint8_t hz);
+
+	/**
+	 * @return the maximum number of transfers per second, 0 if follows the global frame rate.
+	 */
+	uint8_t getMaxRefresh() const;
+
+	/**
+	 * Sets if this device is transferred on its own thread, used by devices that hold a strip shard.
+	 * @param concurrent
+	 */
+	void setConcurrentTransfer(bool concurrent);
+
+	/**
+	 * @return true if this device is transferred on its own thread.
+	 */
+	bool isConcurrentTransfer() const;
+
 	/// Stores devices.
 	static vector<Device*> devices;
 
@@ -195,6 +219,18 @@ protected:
 	/// Copy of device LEDs
 	vector<uint8_t> oldLEDs;
 
+	/// Maximum transfers per second, 0 follows the global frame rate.
+	uint8_t maxRefresh = 0;
+
+	/// Minimum time between transfers.
+	milliseconds refreshInterval{0};
+
+	/// Last time the data was transferred.
+	high_resolution_clock::time_point lastTransfer;
+
+	/// True if the data is transferred on its own thread.
+	bool concurrentTransfer = false;
+
 	/// Maps elements by name.
 	ElementUMap elementsByName;
 
@@ -205,7 +241,16 @@ using DevicePrs = vector<Device*>;
 
 } // namespace
 
+#ifdef DEVICE_PLUGIN_ID
+// Built in devices use unique function names, see DeviceHandler::builtInDevices.
+#define deviceFactoryName(function, id) function ## _ ## id
+#define deviceFactoryId(function, id) deviceFactoryName(function, id)
+#define deviceFactory(plugin) \
+	extern "C" Device* deviceFactoryId(createDevice, DEVICE_PLUGIN_ID)(StringUMap& options) { return new plugin(options); } \
+	extern "C" void deviceFactoryId(destroyDevice, DEVICE_PLUGIN_ID)(Device* instance) { delete instance; }
+#else
 // The functions to create and destroy devices.
 #define deviceFactory(plugin) \
 	extern "C" Device* createDevice(StringUMap& options) { return new plugin(options); } \
 	extern "C" void destroyDevice(Device* instance) { delete instance; }
+#endif
@@ -35,6 +35,23 @@ DeviceHandler::DeviceHandler(const string& deviceName) :
 		throw Error("Failed to load device ") << deviceName << " " << errstr;
 }
 
+DeviceHandler::DeviceHandler(Device*(*createFunction)(StringUMap&), void(*destroyFunction)(Device*)) :
+	createFunction(createFunction),
+	destroyFunction(destroyFunction)
+{}
+
+DeviceHandler* DeviceHandler::loadHandler(const string& deviceName) {
+#ifdef STATIC_DEVICES
+	for (uint8_t c = 0; c < builtInDevicesCount; ++c) {
+		if (deviceName != builtInDevices[c].name)
+			continue;
+		LogDebug("Using built in device " + deviceName);
+		return new DeviceHandler(builtInDevices[c].createFunction, builtInDevices[c].destroyFunction);
+	}
+#endif
+	return new DeviceHandler(deviceName);
+}
+
 DeviceHandler::~DeviceHandler() {
 
 	// Destroy Devices.
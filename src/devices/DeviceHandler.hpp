@@ -35,15 +35,28 @@ class DeviceHandler : public Handler {
 
 public:
 
-	DeviceHandler() = default;
-
 	/**
 	 * @see Handler::Handler()
 	 */
 	DeviceHandler(const string& deviceName);
 
+	/**
+	 * Creates a handler for a device linked into the program.
+	 * @param createFunction
+	 * @param destroyFunction
+	 */
+	DeviceHandler(Device*(*createFunction)(StringUMap&), void(*destroyFunction)(Device*));
+
 	virtual ~DeviceHandler();
 
+	/**
+	 * Returns a new handler for a device, built in devices are preferred,
+	 * otherwise the plugin is loaded from the devices directory.
+	 * @param deviceName
+	 * @return
+	 */
+	static DeviceHandler* loadHandler(const string& deviceName);
+
 	/**
 	 * Creates a device calling the create function and keep record of it.
 	 * @see createFunction pointer.
@@ -55,6 +68,23 @@ public:
 
 protected:
 
+#ifdef STATIC_DEVICES
+	/**
+	 * Device linked into the program.
+	 */
+	struct BuiltInDevice {
+		const char* name;
+		Device*(*createFunction)(StringUMap&);
+		void(*destroyFunction)(Device*);
+	};
+
+	/// Built in devices table, generated at compile time.
+	static const BuiltInDevice builtInDevices[];
+
+	/// Number of built in devices.
+	static const uint8_t builtInDevicesCount;
+#endif
+
 	/// List of created devices.
 	vector<Device*> devices;
 
@@ -88,7 +88,10 @@ void Profile::drawConfig() const {
 
 void Profile::runFrame(bool advanceFrame) {
 
-	if (advanceFrame) Actor::newFrame();
+	if (advanceFrame) {
+		Actor::newFrame();
+		Input::newFrame();
+	}
 
 	// Reset elements.
 	for (const auto& e : Element::allElements) {
@@ -129,10 +132,33 @@ void Profile::runFrame(bool advanceFrame) {
 		eE.second.process(50, nullptr);
 	}
 
+	if (keepFrame) {
+		if (allLeds.empty())
+			allLeds = Group::layout.at("All").getLeds();
+		lastFrame.resize(allLeds.size());
+		for (size_t c = 0; c < allLeds.size(); ++c)
+			lastFrame[c] = *allLeds[c];
+	}
+
 	// Set controlled items from input plugins.
-	for (auto& item : Input::getControlledInputs()) {
-		item.second->process(50, nullptr);
+	Input::drawControlledInputs();
+}
+
+void Profile::runInputFrame() {
+
+	if (lastFrame.empty()) {
+		runFrame(false);
+		return;
 	}
+
+	for (size_t c = 0; c < allLeds.size(); ++c)
+		*allLeds[c] = lastFrame[c];
+
+	if (not transitioning and inputsEnabled) {
+		for (Input* i : inputs) i->process();
+	}
+
+	Input::drawControlledInputs();
 }
 
 void Profile::reset() {
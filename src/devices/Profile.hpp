@@ -66,6 +66,12 @@ public:
 	 */
 	void runFrame(bool advanceFrame = true);
 
+	/**
+	 * Redraws the inputs over the last frame without advancing the animations.
+	 * Only available when keepFrame is set, otherwise runs a frame that does not advance.
+	 */
+	void runInputFrame();
+
 	/**
 	 * Leave the actor and inputs ready to go.
 	 */
@@ -117,6 +123,9 @@ public:
 	/// Stores the default profile.
 	inline static Profile* defaultProfile = nullptr;
 
+	/// Keeps every frame before drawing the controlled inputs, for runInputFrame.
+	inline static bool keepFrame = false;
+
 	/**
 	 * Collect a distinct list of all LED pointers across all Actors.
 	 * Duplicates are removed, order of first encounter is preserved.
@@ -197,6 +206,12 @@ protected:
 	/// Keeps a list of temporary activated on groups across profiles.
 	static GroupItemUMap temporaryOnGroups;
 
+	/// LEDs of the All group.
+	inline static vector<uint8_t*> allLeds;
+
+	/// Last frame before drawing the controlled inputs, when keepFrame is set.
+	inline static vector<uint8_t> lastFrame;
+
 };
 
 using ProfilePtrUMap = unordered_map<string, Profile*>;
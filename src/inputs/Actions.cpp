@@ -52,21 +52,21 @@ Actions::Actions(StringUMap& parameters, ItemPtrUMap& inputMaps) :
 			Utility::trim(mapId);
 			// Convert mapId to trigger.
 			uint16_t mapCode = Utility::parseNumber(mapId, "Unable to parse map ID, is not a number");
-			string trigger;
+			const Trigger* trigger = nullptr;
 			// Find trigger by position from items map.
-			for (const auto& pair : itemsUMap) {
-				if (pair.second->pos == mapCode) {
-					trigger = pair.first;
+			for (const auto& t : triggers) {
+				if (t.item->pos == mapCode) {
+					trigger = &t;
 					break;
 				}
 			}
-			if (trigger.empty()) {
+			if (not trigger) {
 				LogWarning("Ignoring invalid map ID " + mapId);
 				continue;
 			}
-			tempRecord.emplace_back(std::move(Record{trigger, mapIdx == 0, itemsUMap[trigger], nullptr}));
+			tempRecord.emplace_back(std::move(Record{trigger->id, mapIdx == 0, trigger->item, nullptr}));
 			// Update lookup table.
-			groupMapLookup.emplace(trigger, LookupMap{groupIdx, mapIdx++});
+			groupMapLookup.emplace(trigger->code, LookupMap{groupIdx, mapIdx++});
 		}
 		// Link last element to 1st element.
 		tempRecord.back().next = &tempRecord[0];
@@ -91,25 +91,27 @@ void Actions::process() {
 	for (auto& event : events) {
 
 		if (not event.value) continue;
-		if (not itemsUMap.exists(event.trigger)) continue;
+		const Trigger* trigger = findTrigger(event.trigger);
+		if (not trigger) continue;
+		const string& name(*trigger->name);
 
 		// If the trigger already exist remove it so the next can be set
-		removeControlledItemByTrigger(event.trigger);
+		setControlled(trigger->id, false);
 
 		// Non Grouped elements.
-		if (not groupMapLookup.exists(event.trigger)) {
-			if (blinkingItems.exists(event.trigger)) {
-				LogDebug("key: " + event.trigger + " for " + itemsUMap[event.trigger]->getName() + " stop blinking");
-				blinkingItems.erase(event.trigger);
+		if (not groupMapLookup.exists(trigger->code)) {
+			if (blinking.test(trigger->id)) {
+				LogDebug("key: " + name + " for " + trigger->item->getName() + " stop blinking");
+				blinking.reset(trigger->id);
 			}
 			else {
-				LogDebug("key: " + event.trigger + " for " + itemsUMap[event.trigger]->getName() + " start blinking");
-				blinkingItems.emplace(event.trigger, itemsUMap[event.trigger]);
+				LogDebug("key: " + name + " for " + trigger->item->getName() + " start blinking");
+				blinking.set(trigger->id);
 			}
 			continue;
 		}
 
-		auto& lookupMap(groupMapLookup[event.trigger]);
+		auto& lookupMap(groupMapLookup[trigger->code]);
 		// grouped elements.
 		Record& groupMap = groupsMaps[lookupMap.groupIdx][lookupMap.mapIdx];
 
@@ -118,17 +120,17 @@ void Actions::process() {
 
 		// Move to the next element.
 		groupMap.active = false;
-		blinkingItems.erase(event.trigger);
-		blinkingItems.emplace(groupMap.next->map, groupMap.next->item);
+		blinking.reset(trigger->id);
+		blinking.set(groupMap.next->id);
 		groupMap.next->active = true;
-		LogDebug("key: " + event.trigger + " for " + groupMap.item->getName() + " switches to: " + groupMap.next->item->getName());
+		LogDebug("key: " + name + " for " + groupMap.item->getName() + " switches to: " + groupMap.next->item->getName());
 	}
 }
 
 void Actions::activate() {
 	for (auto& group : groupsMaps) {
 		Record& groupMap = group.front();
-		blinkingItems.emplace(groupMap.map, groupMap.item);
+		blinking.set(groupMap.id);
 		groupMap.active = true;
 	}
 	Reader::activate();
@@ -138,7 +140,7 @@ void Actions::deactivate() {
 	for (auto& g : groupsMaps)
 		for (auto& i : g)
 			i.active = false;
-	blinkingItems.clear();
+	blinking.clear();
 	Reader::deactivate();
 }
 
@@ -159,22 +161,15 @@ void Actions::drawConfig() const {
 
 void Actions::blink() {
 	if (not doBlink) {
-		for (auto& e : blinkingItems)
-			if (not controlledItems.exists(e.first))
-				controlledItems.emplace(e.first, e.second);
+		controlledOn.set(blinking);
 		return;
 	}
-	if (frames == cframe) {
-		cframe = 0;
-		for (auto& e : blinkingItems) {
-			if (on)
-				controlledItems.erase(e.first);
-			else
-				controlledItems.emplace(e.first, e.second);
-		}
-		on = not on;
-	}
-	else {
-		++cframe;
-	}
+	bool phase = blinkPhase(frames);
+	if (phase == on)
+		return;
+	on = phase;
+	if (on)
+		controlledOn.set(blinking);
+	else
+		controlledOn.reset(blinking);
 }
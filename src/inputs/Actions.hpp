@@ -56,20 +56,20 @@ protected:
 
 		Record() = default;
 
-		Record(string map, bool active, Items* item, Record* next) :
-			map(map),
+		Record(uint16_t id, bool active, Items* item, Record* next) :
+			id(id),
 			active(active),
 			item(item),
 			next(next) {}
 
 		Record(const Record& other) :
-			map(other.map),
+			id(other.id),
 			active(other.active),
 			item(other.item),
 			next(other.next) {}
 
-		/// trigger map value.
-		string map;
+		/// Controlled item id.
+		uint16_t id = 0;
 
 		/// If true, the item is active.
 		bool active = false;
@@ -88,9 +88,7 @@ protected:
 			mapIdx   = 0;
 	};
 
-	uint8_t
-		frames,
-		cframe = 0;
+	uint8_t frames;
 
 	/// Keeps the ON/OFF flag.
 	bool on = false;
@@ -102,10 +100,10 @@ protected:
 	vector<vector<Record>> groupsMaps;
 
 	/// Small lookup table by trigger, to avoid a loop every time we need to seek an item.
-	unordered_map<string, LookupMap> groupMapLookup;
+	unordered_map<uint32_t, LookupMap> groupMapLookup;
 
 	/// Elements or Groups blinking.
-	ItemPtrUMap blinkingItems;
+	Bitset blinking;
 
 	void blink();
 
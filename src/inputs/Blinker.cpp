@@ -28,11 +28,6 @@ void Blinker::process() {
 
 	readAll();
 
-	for (auto& e :itemsToClean)
-		blinkingItems.erase(e);
-
-	itemsToClean.clear();
-
 	blink();
 
 	if (not events.size())
@@ -43,19 +38,18 @@ void Blinker::process() {
 		if (not event.value)
 			continue;
 
-		if (itemsUMap.exists(event.trigger)) {
-			LogDebug("key: " + event.trigger + " adds: " + to_string(times) + " times to element: " + itemsUMap[event.trigger]->getName());
+		const Trigger* trigger = findTrigger(event.trigger);
+		if (trigger) {
+			LogDebug("key: " + *trigger->name + " adds: " + to_string(times) + " times to element: " + trigger->item->getName());
 			// switch
-			if (blinkingItems.exists(event.trigger))
-				blinkingItems[event.trigger].times = 0;
-			else
-				blinkingItems.emplace(event.trigger, Times{itemsUMap[event.trigger], 0});
+			blinking.set(trigger->id);
+			blinks[trigger->id] = 0;
 		}
 	}
 }
 
 void Blinker::deactivate() {
-	blinkingItems.clear();
+	blinking.clear();
 	Reader::deactivate();
 }
 
@@ -67,26 +61,20 @@ void Blinker::drawConfig() const {
 }
 
 void Blinker::blink() {
-	if (frames == cframe) {
-		cframe = 0;
-		for (auto& i : blinkingItems) {
-			// deactivate after time passed.
-			if (i.second.times == times) {
-				controlledItems.erase(i.first);
-				itemsToClean.push_back(i.first);
-				continue;
-			}
-			if (on) {
-				controlledItems.erase(i.first);
-			}
-			else {
-				controlledItems.emplace(i.first, i.second.item);
-				++i.second.times;
-			}
-		}
-		on = not on;
-	}
-	else {
-		++cframe;
+	bool phase = blinkPhase(frames);
+	if (phase == on)
+		return;
+	on = phase;
+	if (not on) {
+		controlledOn.reset(blinking);
+		return;
 	}
+	blinking.forEach([&](size_t id) {
+		// deactivate after time passed.
+		if (blinks[id] == times)
+			blinking.reset(id);
+		else
+			++blinks[id];
+	});
+	controlledOn.set(blinking);
 }
@@ -41,7 +41,8 @@ public:
 		Reader(parameters, inputMaps),
 		Speed(parameters.exists("speed") ? parameters["speed"] : "Normal"),
 		frames(static_cast<uint8_t>(speed) * 3),
-		times(Utility::parseNumber(parameters.exists("times") ? parameters["times"] : DEFAULT_BLINKS, "Invalid numeric value ")) {}
+		times(Utility::parseNumber(parameters.exists("times") ? parameters["times"] : DEFAULT_BLINKS, "Invalid numeric value ")),
+		blinks(controlledItems.size(), 0) {}
 
 	virtual ~Blinker() = default;
 
@@ -55,19 +56,16 @@ protected:
 
 	uint8_t
 		frames,
-		times,
-		cframe = 0;
+		times;
 
+	/// Last blink phase.
 	bool on = false;
 
-	struct Times {
-		Items* item;
-		uint8_t times = 0;
-	};
+	/// Controlled items blinking.
+	Bitset blinking;
 
-	unordered_map<string, Times> blinkingItems;
-
-	vector<string> itemsToClean;
+	/// Times blinked by controlled item id.
+	vector<uint8_t> blinks;
 
 	void blink();
 
@@ -57,21 +57,21 @@ Credits::Credits(StringUMap& parameters, ItemPtrUMap& inputMaps) :
 			Utility::trim(mapId);
 			// Convert mapId to trigger.
 			uint16_t mapCode = Utility::parseNumber(mapId, "Unable to parse map ID, is not a number");
-			string trigger;
+			const Trigger* trigger = nullptr;
 			// Find trigger by position from items map.
-			for (const auto& pair : itemsUMap) {
-				if (pair.second->pos == mapCode) {
-					trigger = pair.first;
+			for (const auto& t : triggers) {
+				if (t.item->pos == mapCode) {
+					trigger = &t;
 					break;
 				}
 			}
-			if (trigger.empty()) {
+			if (not trigger) {
 				LogWarning("Ignoring invalid map ID " + mapId);
 				continue;
 			}
-			tempRecord.emplace_back(std::move(Record{trigger, mapIdx == 0, itemsUMap[trigger]}));
+			tempRecord.emplace_back(std::move(Record{trigger->id, mapIdx == 0, trigger->item}));
 			// Update lookup table.
-			groupMapLookup.emplace(trigger, LookupMap{groupIdx, mapIdx++});
+			groupMapLookup.emplace(trigger->code, LookupMap{groupIdx, mapIdx++});
 		}
 
 		groupsMaps.emplace_back(std::move(tempRecord));
@@ -93,10 +93,11 @@ void Credits::process() {
 
 		if (not event.value) continue;
 
-		if (not itemsUMap.exists(event.trigger)) continue;
+		const Trigger* trigger = findTrigger(event.trigger);
+		if (not trigger) continue;
 
 		// Lookup Trigger.
-		auto& lookupMap(groupMapLookup[event.trigger]);
+		auto& lookupMap(groupMapLookup[trigger->code]);
 		// Pick record data.
 		Record& groupMap = groupsMaps[lookupMap.groupIdx][lookupMap.mapIdx];
 		// Not active, done.
@@ -136,8 +137,8 @@ void Credits::process() {
 			if (groupMap.active and not alwaysOn and ((allOn and mode == Modes::Multi) or mode == Modes::Single)) {
 				// Stop Coin Blinking.
 				LogDebug("Stop Coin for " + groupMap.item->getName());
-				removeControlledItemByTrigger(event.trigger);
-				blinkingItems.erase(event.trigger);
+				setControlled(trigger->id, false);
+				blinking.reset(trigger->id);
 				if (mode == Modes::Multi or allOn)
 					groupMap.active = false;
 			}
@@ -146,20 +147,20 @@ void Credits::process() {
 
 			// Set next Start on
 			record->active = true;
-			blinkingItems.emplace(record->map, record->item);
+			blinking.set(record->id);
 			LogDebug("Start: " + record->item->getName() + " Active");
 		}
 		else {
-			removeControlledItemByTrigger(event.trigger);
+			setControlled(trigger->id, false);
 			groupMap.active = false;
-			blinkingItems.erase(event.trigger);
+			blinking.reset(trigger->id);
 
 			if (not once and not alwaysOn) {
 				// Set start back on.
 				Record& coin = groupsMaps[lookupMap.groupIdx][0];
 				coin.active = true;
-				if (not blinkingItems.exists(coin.map)) {
-					blinkingItems.emplace(coin.map, coin.item);
+				if (not blinking.test(coin.id)) {
+					blinking.set(coin.id);
 					LogDebug("Credit: " + coin.item->getName() + " Active");
 				}
 			}
@@ -171,7 +172,7 @@ void Credits::activate() {
 	for (auto& group : groupsMaps) {
 		for (size_t c = 0; c < group.size(); ++c) {
 			if (c == 0) {
-				blinkingItems.emplace(group[c].map, group[c].item);
+				blinking.set(group[c].id);
 				group[c].active = true;
 			}
 			else {
@@ -186,7 +187,7 @@ void Credits::deactivate() {
 	for (auto& g : groupsMaps)
 		for (auto& i : g)
 			i.active = false;
-	blinkingItems.clear();
+	blinking.clear();
 	Reader::deactivate();
 }
 
@@ -212,17 +213,12 @@ void Credits::drawConfig() const {
 }
 
 void Credits::blink() {
-	if (frames == cframe) {
-		cframe = 0;
-		for (auto& e : blinkingItems) {
-			if (on)
-				controlledItems.erase(e.first);
-			else
-				controlledItems.emplace(e.first, e.second);
-		}
-		on = not on;
-	}
-	else {
-		++cframe;
-	}
+	bool phase = blinkPhase(frames);
+	if (phase == on)
+		return;
+	on = phase;
+	if (on)
+		controlledOn.set(blinking);
+	else
+		controlledOn.reset(blinking);
 }
@@ -73,18 +73,18 @@ protected:
 
 		Record() = default;
 
-		Record(string map, bool active, Items* item) :
-			map(map),
+		Record(uint16_t id, bool active, Items* item) :
+			id(id),
 			active(active),
 			item(item) {}
 
 		Record(const Record& other) :
-			map(other.map),
+			id(other.id),
 			active(other.active),
 			item(other.item) {}
 
-		/// trigger map value.
-		string map;
+		/// Controlled item id.
+		uint16_t id = 0;
 
 		/// If true, the item is active.
 		bool active = false;
@@ -102,7 +102,6 @@ protected:
 
 	uint8_t
 		frames,
-		cframe = 0,
 		coinsPerCredit;
 
 	Modes mode = Modes::Multi;
@@ -120,10 +119,10 @@ protected:
 	vector<vector<Record>> groupsMaps;
 
 	/// Small lookup table by trigger, to avoid a loop every time we need to seek an item.
-	unordered_map<string, LookupMap> groupMapLookup;
+	unordered_map<uint32_t, LookupMap> groupMapLookup;
 
 	/// Elements or Groups blinking.
-	ItemPtrUMap blinkingItems;
+	Bitset blinking;
 
 	void blink();
 
@@ -37,15 +37,15 @@ void Impulse::process() {
 		return;
 
 	for (auto& event : events) {
-		if (itemsUMap.exists(event.trigger)) {
-			if (controlledItems.exists(event.trigger)) {
-				// released
-				if (not event.value)
-					controlledItems.erase(event.trigger);
-			}
-			else
-				// activated
-				controlledItems.emplace(event.trigger, itemsUMap[event.trigger]);
+		const Trigger* trigger = findTrigger(event.trigger);
+		if (not trigger) continue;
+		if (isControlled(trigger->id)) {
+			// released
+			if (not event.value)
+				setControlled(trigger->id, false);
 		}
+		else
+			// activated
+			setControlled(trigger->id, true);
 	}
 }
@@ -24,20 +24,51 @@
 
 using namespace LEDSpicer::Inputs;
 
-ItemPtrUMap Input::controlledItems;
+vector<Items*> Input::controlledItems;
+Bitset Input::controlledOn;
+vector<uint16_t> Input::freeIds;
+uint32_t Input::blinkClock = 0;
+
+Input::Input(StringUMap&, ItemPtrUMap& inputMaps) : itemsUMap(std::move(inputMaps)) {
+	for (auto& p : itemsUMap) {
+		uint16_t id;
+		if (freeIds.empty()) {
+			id = controlledItems.size();
+			controlledItems.push_back(p.second);
+		}
+		else {
+			id = freeIds.back();
+			freeIds.pop_back();
+			controlledItems[id] = p.second;
+		}
+		itemIds.emplace(p.first, id);
+	}
+	controlledOn.resize(controlledItems.size());
+}
 
 Input::~Input() {
 	LogDebug("Releasing input maps...");
+	for (auto& p : itemIds) {
+		controlledOn.reset(p.second);
+		controlledItems[p.second] = nullptr;
+		freeIds.push_back(p.second);
+	}
 	for (auto& p : itemsUMap)
 		delete p.second;
 }
 
-const ItemPtrUMap& Input::getControlledInputs() {
-	return Input::controlledItems;
+void Input::drawControlledInputs() {
+	controlledOn.forEach([](size_t id) {
+		controlledItems[id]->process(50, nullptr);
+	});
 }
 
 void Input::clearControlledInputs() {
-	Input::controlledItems.clear();
+	controlledOn.clear();
+}
+
+void Input::newFrame() {
+	++blinkClock;
 }
 
 void Input::drawConfig() const {
@@ -61,10 +92,18 @@ string Input::findItemMapByName(string& name) {
 	throw Error("Unable to find item named ") << name;
 }
 
-bool Input::removeControlledItemByTrigger(const string& trigger) {
-	if (controlledItems.exists(trigger)) {
-		controlledItems.erase(trigger);
-		return true;
-	}
-	return false;
+bool Input::isControlled(uint16_t id) {
+	return controlledOn.test(id);
+}
+
+void Input::setControlled(uint16_t id, bool on) {
+	if (on)
+		controlledOn.set(id);
+	else
+		controlledOn.reset(id);
+}
+
+bool Input::blinkPhase(uint8_t frames) {
+	// A phase lasts frames + 1, like the frame counters it replaces.
+	return (blinkClock / (frames + 1u)) & 1;
 }
@@ -24,6 +24,8 @@
 #include "devices/Element.hpp"
 #include "utilities/Log.hpp"
 #include "utilities/Utility.hpp"
+#include "utilities/Bitset.hpp"
+#include "utilities/Recorder.hpp"
 
 using namespace LEDSpicer::Devices;
 using namespace LEDSpicer::Utilities;
@@ -39,24 +41,25 @@ class Input {
 
 public:
 
-	Input(
-		StringUMap&,
-		ItemPtrUMap& inputMaps
-	) : itemsUMap(std::move(inputMaps)) {}
+	Input(StringUMap&, ItemPtrUMap& inputMaps);
 
 	virtual ~Input();
 
 	/**
-	 * Returns a list of controlled items.
-	 * @return
+	 * Draws the controlled items that are on.
 	 */
-	static const ItemPtrUMap& getControlledInputs();
+	static void drawControlledInputs();
 
 	/**
-	 * Removes all input registered inputs.
+	 * Turns off all the controlled items.
 	 */
 	static void clearControlledInputs();
 
+	/**
+	 * Advances the clock used to blink.
+	 */
+	static void newFrame();
+
 	/**
 	 * Draws the input configuration.
 	 */
@@ -81,12 +84,24 @@ public:
 
 protected:
 
-	/// List of elements that need to be Output, mapped items by trigger.
-	static ItemPtrUMap controlledItems;
+	/// Items of all the inputs by id, the id is kept while the input exists.
+	static vector<Items*> controlledItems;
+
+	/// Controlled items that are on.
+	static Bitset controlledOn;
+
+	/// Ids released by deleted inputs.
+	static vector<uint16_t> freeIds;
+
+	/// Frames counter shared by the inputs that blink.
+	static uint32_t blinkClock;
 
 	/// Input specific map. trigger -> Item.
 	ItemPtrUMap itemsUMap;
 
+	/// Controlled item id by trigger.
+	unordered_map<string, uint16_t> itemIds;
+
 	/**
 	 * @param name
 	 * @return string, the map using the element or group name.
@@ -94,11 +109,24 @@ protected:
 	string findItemMapByName(string& name);
 
 	/**
-	 * Attempts to remove an item by its trigger.
-	 * @param trigger trigger to remove
-	 * @return true if the item was removed, false instead.
+	 * @param id
+	 * @return true if the controlled item is on.
+	 */
+	static bool isControlled(uint16_t id);
+
+	/**
+	 * Turns a controlled item on or off.
+	 * @param id
+	 * @param on
+	 */
+	static void setControlled(uint16_t id, bool on);
+
+	/**
+	 * Inputs blinking at the same speed share the phase.
+	 * @param frames frames on each phase.
+	 * @return true on the on phase.
 	 */
-	static bool removeControlledItemByTrigger(const string& trigger);
+	static bool blinkPhase(uint8_t frames);
 
 };
 
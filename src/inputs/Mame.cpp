@@ -24,6 +24,15 @@
 
 using namespace LEDSpicer::Inputs;
 
+Mame::Mame(StringUMap& parameters, ItemPtrUMap& inputMaps) : Input(parameters, inputMaps) {
+	outputs.reserve(itemsUMap.size());
+	for (auto& m : itemsUMap) {
+		outputsByName.emplace(m.first, outputs.size());
+		outputs.push_back(Output{&m.first, itemIds.at(m.first), false, false});
+	}
+	changed.reserve(outputs.size());
+}
+
 void Mame::drawConfig() const {
 	cout << "Mame" << endl;
 	Input::drawConfig();
@@ -33,52 +42,43 @@ void Mame::process() {
 
 	if (not active) return;
 
-	if (not socks.isConnected()) activate();
-
-	string buffer;
-	if (not socks.receive(buffer)) return;
-
-	// Mame sent carriage return
-	std::replace(buffer.begin(), buffer.end(), '\r', '\n');
-	buffer.erase(std::remove(buffer.begin(), buffer.end(), ' '), buffer.end());
-
-	if (buffer.empty()) return;
-
-	// Process each line separately.
-	for (string& line : Utility::explode(buffer, '\n')) {
-
-		if (line.empty()) continue;
-
-		LogDebug("Message received " + line);
-
-		if (line.find("mame_stop") != string::npos) {
-			active = false;
-			return;
+	if (Recorder::isReplaying()) {
+		string recorded;
+		while (Recorder::next(Recorder::Sources::Mame, recorded)) {
+			// Empty when the connection was closed.
+			if (recorded.empty() or not parse(recorded.data(), recorded.size()))
+				resetLine();
 		}
+		applyChanges();
+		return;
+	}
 
-		if (line.find("mame_start") != string::npos) continue;
-
-		auto parts = Utility::explode(line, '=');
-		if (parts.size() != 2) continue;
-
-		if (not itemsUMap.exists(parts[0])) continue;
-
-		bool on = not parts[1].empty() and parts[1][0] != '0';
-		LogDebug("Sending: " + parts[0] + " " + (on ? "on" : "off"));
+	if (not socks.isConnected()) activate();
 
-		if (on) {
-			if (not controlledItems.exists(parts[0]))
-				controlledItems.emplace(parts[0], itemsUMap[parts[0]]);
+	while (true) {
+		ssize_t r = socks.receive(buffer.data(), buffer.size());
+		if (r) Recorder::record(Recorder::Sources::Mame, buffer.data(), r < 0 ? 0 : r);
+		if (r < 0) {
+			socks.disconnect();
+			resetLine();
+			break;
 		}
-		else {
-			controlledItems.erase(parts[0]);
+		if (r == 0) break;
+		if (not parse(buffer.data(), r)) {
+			resetLine();
+			break;
 		}
+		// A short read means there is nothing else pending.
+		if (static_cast<size_t>(r) < buffer.size()) break;
 	}
+
+	applyChanges();
 }
 
 void Mame::activate() {
 	active = true;
-	if (socks.isConnected()) return;
+	if (socks.isConnected() or Recorder::isReplaying()) return;
+	resetLine();
 	try {
 		// Open connection.
 		socks.prepare(LOCALHOST, MAME_PORT, false, SOCK_STREAM);
@@ -89,4 +89,91 @@ void Mame::activate() {
 void Mame::deactivate() {
 	socks.disconnect();
 	active = false;
+	resetLine();
+	for (auto& output : outputs)
+		output.pending = false;
+	changed.clear();
+}
+
+bool Mame::parse(const char* data, size_t size) {
+	for (size_t c = 0; c < size; ++c) {
+		char character = data[c];
+		// Mame sends carriage returns and spaces around the equal sign.
+		if (character == '\r' or character == '\n') {
+			if (not endLine())
+				return false;
+			continue;
+		}
+		if (character == ' ')
+			continue;
+		switch (lineState) {
+		case LineStates::Name:
+			if (character == '=')
+				lineState = LineStates::Value;
+			else if (nameLength < MAME_NAME_SIZE)
+				name[nameLength++] = character;
+			else
+				lineState = LineStates::Invalid;
+			break;
+		case LineStates::Value:
+			on        = character != '0';
+			lineState = character == '=' ? LineStates::Invalid : LineStates::ValueRead;
+			break;
+		case LineStates::ValueRead:
+			if (character == '=')
+				lineState = LineStates::Invalid;
+			break;
+		case LineStates::Invalid:
+			break;
+		}
+	}
+	return true;
+}
+
+bool Mame::endLine() {
+
+	std::string_view line(name.data(), nameLength);
+	LineStates state = lineState;
+	bool value       = on;
+	resetLine();
+
+	if (line.empty()) return true;
+
+	LogDebug("Message received " + string(line) + (state == LineStates::Invalid ? " invalid" : (value ? " on" : " off")));
+
+	if (line.find("mame_stop") != std::string_view::npos) {
+		active = false;
+		return false;
+	}
+
+	if (state == LineStates::Name or state == LineStates::Invalid or line.find("mame_start") != std::string_view::npos)
+		return true;
+
+	auto output = outputsByName.find(line);
+	if (output == outputsByName.end()) return true;
+
+	// Only the last update of the frame is applied.
+	Output& o = outputs[output->second];
+	if (not o.pending) {
+		o.pending = true;
+		changed.push_back(output->second);
+	}
+	o.on = value;
+	return true;
+}
+
+void Mame::resetLine() {
+	nameLength = 0;
+	lineState  = LineStates::Name;
+	on         = false;
+}
+
+void Mame::applyChanges() {
+	for (uint16_t index : changed) {
+		Output& output = outputs[index];
+		output.pending = false;
+		LogDebug("Sending: " + *output.name + " " + (output.on ? "on" : "off"));
+		setControlled(output.id, output.on);
+	}
+	changed.clear();
 }
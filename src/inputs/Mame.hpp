@@ -22,11 +22,18 @@
 
 #include "Input.hpp"
 #include "utilities/Socks.hpp"
+#include <string_view>
 
 #pragma once
 
 #define MAME_PORT "8000"
 
+/// Bytes read from MAME by a single system call.
+#define MAME_BUFFER_SIZE 4096
+
+/// Longest output name, longer names are ignored.
+#define MAME_NAME_SIZE 64
+
 namespace LEDSpicer::Inputs {
 
 using LEDSpicer::Utilities::Socks;
@@ -34,12 +41,15 @@ using LEDSpicer::Utilities::Socks;
 /**
  * LEDSpicer::Inputs::Mame
  * This input plugin connects to MAME output network port 8000 and read the output states.
+ *
+ * The lines (name = value) are parsed as they arrive, a line split between two reads is completed on the next one.
+ * The output names are mapped once to their items, several updates of the same output on a frame only apply the last one.
  */
 class Mame: public Input {
 
 public:
 
-	using Input::Input;
+	Mame(StringUMap& parameters, ItemPtrUMap& inputMaps);
 
 	virtual ~Mame() = default;
 
@@ -50,9 +60,68 @@ public:
 
 protected:
 
+	struct Output {
+		/// Output name, key on itemsUMap.
+		const string* name;
+		/// Controlled item id.
+		uint16_t id;
+		/// Last state received on this frame.
+		bool on;
+		/// True if the output changed on this frame.
+		bool pending;
+	};
+
 	Socks socks;
 
 	bool active = true;
+
+	/// Mapped outputs.
+	vector<Output> outputs;
+
+	/// Output index by name.
+	std::unordered_map<std::string_view, uint16_t> outputsByName;
+
+	/// Outputs changed on this frame, in arrival order.
+	vector<uint16_t> changed;
+
+	/// Receive buffer.
+	array<char, MAME_BUFFER_SIZE> buffer;
+
+	/// Name of the line being parsed.
+	array<char, MAME_NAME_SIZE> name;
+
+	/// Name length, up to MAME_NAME_SIZE, a longer name sets the line Invalid.
+	uint8_t nameLength = 0;
+
+	/// Parser states: reading the name, waiting the value, value read, invalid line.
+	enum class LineStates : uint8_t {Name, Value, ValueRead, Invalid} lineState = LineStates::Name;
+
+	/// Value of the line being parsed.
+	bool on = false;
+
+	/**
+	 * Parses received bytes, carrying an incomplete line to the next call.
+	 * @param data
+	 * @param size
+	 * @return false if MAME stopped.
+	 */
+	bool parse(const char* data, size_t size);
+
+	/**
+	 * Handles a complete line.
+	 * @return false if MAME stopped.
+	 */
+	bool endLine();
+
+	/**
+	 * Clears the line being parsed.
+	 */
+	void resetLine();
+
+	/**
+	 * Applies the changed outputs into the controlled items.
+	 */
+	void applyChanges();
 };
-} // namespace
 
+} // namespace
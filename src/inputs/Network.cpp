@@ -54,14 +54,11 @@ void Network::process() {
 #ifdef DEVELOP
 		LogDebug("Processing " + entry);
 #endif
-		if (itemsUMap.exists(entry)) {
-			if (removeControlledItemByTrigger(entry)) {
-				LogDebug("map " + entry +" Off");
-			}
-			else {
-				LogDebug("map " + entry +" On");
-				controlledItems.emplace(entry, itemsUMap[entry]);
-			}
+		if (itemIds.exists(entry)) {
+			uint16_t id = itemIds[entry];
+			bool on     = not isControlled(id);
+			LogDebug("map " + entry + (on ? " On" : " Off"));
+			setControlled(id, on);
 		}
 	}
 }
@@ -27,19 +27,68 @@ using namespace LEDSpicer::Inputs;
 vector<Reader::ReadData> Reader::events;
 unordered_map<string, Reader::ListenEventData> Reader::listenEvents;
 Input* Reader::readController = nullptr;
+SPSCQueue<Reader::ReadData, INPUT_QUEUE_SIZE> Reader::queue;
+std::thread Reader::inputThread;
+int
+	Reader::epollFd = -1,
+	Reader::stopFd  = -1,
+	Reader::wakeFd  = -1;
+std::atomic<uint32_t> Reader::dropped {0};
+int64_t
+	Reader::pressTime    = 0,
+	Reader::latencyTotal = 0,
+	Reader::latencyMax   = 0;
+uint16_t
+	Reader::latencyCount = 0,
+	Reader::instances    = 0;
+
+/// Epoll data for the stop event.
+#define STOP_EVENT UINT64_MAX
 
 Reader::Reader(StringUMap& parameters, ItemPtrUMap& inputMaps) : Input(parameters, inputMaps) {
+	++instances;
+	// Listen event index by source position on this input.
+	vector<uint8_t> sources;
 	if (parameters.exists("listenEvents")) {
 		for (auto& e : Utility::explode(parameters["listenEvents"], FIELD_SEPARATOR)) {
 			Utility::trim(e);
 			if (not listenEvents.exists(e))
-				listenEvents.emplace(e, ListenEventData{-1, static_cast<uint8_t>(listenEvents.size())});
+				listenEvents.emplace(e, ListenEventData{-1, static_cast<uint8_t>(listenEvents.size()), false});
+			sources.push_back(listenEvents[e].index);
 		}
 	}
+
+	// Triggers are source:code, resolved to the listen event index.
+	for (auto& m : itemsUMap) {
+		auto parts = Utility::explode(m.first, TRIGGER_SEPARATOR);
+		if (parts.size() != 2)
+			throw Error("Invalid trigger ") << m.first;
+		uint16_t source = Utility::parseNumber(parts[0], "Invalid trigger " + m.first);
+		if (source >= sources.size())
+			throw Error("Trigger without source ") << m.first;
+		uint16_t code = Utility::parseNumber(parts[1], "Invalid trigger " + m.first);
+		triggers.push_back(Trigger{makeTrigger(sources[source], code), &m.first, m.second, itemIds.at(m.first)});
+	}
+	std::sort(triggers.begin(), triggers.end(), [](const Trigger& a, const Trigger& b) {
+		return a.code < b.code;
+	});
+}
+
+Reader::~Reader() {
+	if (--instances)
+		return;
+	stopInputThread();
+	if (wakeFd >= 0) {
+		close(wakeFd);
+		wakeFd = -1;
+	}
 }
 
 void Reader::activate() {
 	readController = nullptr;
+	// Replays feed the recorded events.
+	if (Recorder::isReplaying()) return;
+	bool opened = false;
 	for (auto& l : listenEvents) {
 		// Ignore already connected elements.
 		if (l.second.rCode >= 0) continue;
@@ -47,11 +96,19 @@ void Reader::activate() {
 		l.second.rCode = open((DEV_INPUT + l.first).c_str(), O_RDONLY | O_NONBLOCK);
 		if (l.second.rCode < 0) {
 			LogWarning("Unable to open " DEV_INPUT + l.first);
+			continue;
 		}
+		// Events stamped with the same clock used to measure the latency.
+		int clock = CLOCK_MONOTONIC;
+		l.second.monotonic = ioctl(l.second.rCode, EVIOCSCLOCKID, &clock) == 0;
+		opened = true;
 	}
+	if (opened or not inputThread.joinable())
+		startInputThread();
 }
 
 void Reader::deactivate() {
+	stopInputThread();
 	for (auto& l : listenEvents) {
 		if (l.second.rCode < 0) continue;
 		LogInfo("Closing device " DEV_INPUT + l.first);
@@ -75,17 +132,180 @@ void Reader::readAll() {
 	if (readController != this) return;
 
 	events.clear();
+	ReadData data;
+	if (Recorder::isReplaying()) {
+		string recorded;
+		while (Recorder::next(Recorder::Sources::Input, recorded)) {
+			if (recorded.size() != sizeof(data)) continue;
+			std::memcpy(&data, recorded.data(), sizeof(data));
+			events.push_back(data);
+		}
+		return;
+	}
+	while (queue.pop(data)) {
+		Recorder::record(Recorder::Sources::Input, &data, sizeof(data));
+		LogDebug("Trigger " + to_string(data.trigger >> 16) + TRIGGER_SEPARATOR + to_string(data.trigger & 0xFFFF) + (data.value ? " ON" : " OFF"));
+		// Key repeats are not presses.
+		if (data.value == 1 and not pressTime)
+			pressTime = data.time;
+		events.push_back(data);
+	}
+	if (uint32_t lost = dropped.exchange(0))
+		LogWarning(to_string(lost) + " input events lost, the input queue was full");
+}
+
+bool Reader::waitForInput(milliseconds timeout) {
+	if (not inputThread.joinable()) {
+		sleep_for(timeout);
+		return false;
+	}
+	pollfd wake {wakeFd, POLLIN, 0};
+	if (poll(&wake, 1, timeout.count()) < 1)
+		return false;
+	eventfd_t value;
+	eventfd_read(wakeFd, &value);
+	return true;
+}
+
+void Reader::reportLatency() {
+	if (not pressTime)
+		return;
+	int64_t latency = now() - pressTime;
+	pressTime     = 0;
+	latencyTotal += latency;
+	latencyMax    = std::max(latencyMax, latency);
+	if (++latencyCount < LATENCY_REPORT)
+		return;
+	LogInfo(
+		"Press to light latency over " + to_string(latencyCount) + " presses: average " +
+		to_string(latencyTotal / latencyCount / 1000) + "ms maximum " + to_string(latencyMax / 1000) + "ms"
+	);
+	latencyTotal = latencyMax = latencyCount = 0;
+}
+
+const Reader::Trigger* Reader::findTrigger(uint32_t code) const {
+	auto t = std::lower_bound(triggers.begin(), triggers.end(), code, [](const Trigger& trigger, uint32_t code) {
+		return trigger.code < code;
+	});
+	return t != triggers.end() and t->code == code ? &*t : nullptr;
+}
+
+uint32_t Reader::makeTrigger(uint8_t index, uint16_t code) {
+	return static_cast<uint32_t>(index) << 16 | code;
+}
+
+void Reader::startInputThread() {
+
+	stopInputThread();
+
+	if (wakeFd < 0)
+		wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	stopFd  = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	epollFd = epoll_create1(EPOLL_CLOEXEC);
+
+	epoll_event event {};
+	event.events   = EPOLLIN;
+	event.data.u64 = STOP_EVENT;
+	if (wakeFd < 0 or stopFd < 0 or epollFd < 0 or epoll_ctl(epollFd, EPOLL_CTL_ADD, stopFd, &event) == -1) {
+		LogError("Unable to start the input thread " + string(strerror(errno)));
+		stopInputThread();
+		return;
+	}
+
+	bool listening = false;
 	for (auto& l : listenEvents) {
 		if (l.second.rCode < 0) continue;
+		// The thread gets everything it needs from the event data.
+		event.data.u64 =
+			static_cast<uint32_t>(l.second.rCode) |
+			static_cast<uint64_t>(l.second.index) << 32 |
+			static_cast<uint64_t>(l.second.monotonic) << 40;
+		if (epoll_ctl(epollFd, EPOLL_CTL_ADD, l.second.rCode, &event) == -1) {
+			LogWarning("Unable to listen to " DEV_INPUT + l.first + " " + strerror(errno));
+			continue;
+		}
+		listening = true;
+	}
 
-		input_event event;
-		while (true) {
-			ssize_t r = read(l.second.rCode, &event, sizeof(event));
-			if (r < 1) break;
-			if (event.type != EV_KEY) continue; // and event.type != EV_REL))
-			string code(std::to_string(event.code));
-			LogDebug(l.first + " - Type: " + (event.type == 1 ? "Key" : "Other") + " code: " + code + string(event.value ? " ON" : " OFF"));
-			events.push_back({std::to_string(l.second.index) + code, event.type, event.value});
+	if (not listening) {
+		stopInputThread();
+		return;
+	}
+
+	queue.clear();
+	inputThread = std::thread(&Reader::inputLoop);
+}
+
+void Reader::stopInputThread() {
+	if (inputThread.joinable()) {
+		eventfd_write(stopFd, 1);
+		inputThread.join();
+	}
+	if (epollFd >= 0)
+		close(epollFd);
+	if (stopFd >= 0)
+		close(stopFd);
+	epollFd = stopFd = -1;
+}
+
+void Reader::inputLoop() {
+
+	epoll_event ready[READ_EVENTS];
+	input_event buffer[READ_EVENTS];
+
+	while (true) {
+		int total = epoll_wait(epollFd, ready, READ_EVENTS, -1);
+		if (total < 0) {
+			if (errno == EINTR) continue;
+			LogError("Input thread failed " + string(strerror(errno)));
+			return;
+		}
+
+		bool queued = false;
+		for (int c = 0; c < total; ++c) {
+			uint64_t data = ready[c].data.u64;
+			if (data == STOP_EVENT)
+				return;
+
+			int     fd        = static_cast<int>(data & 0xFFFFFFFF);
+			uint8_t index     = (data >> 32) & 0xFF;
+			bool    monotonic = data >> 40;
+
+			while (true) {
+				ssize_t r = read(fd, buffer, sizeof(buffer));
+				if (r < static_cast<ssize_t>(sizeof(input_event))) {
+					// The device is gone, stop listening to it.
+					if (r < 0 and errno != EAGAIN and errno != EINTR)
+						epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+					break;
+				}
+				size_t events = r / sizeof(input_event);
+				for (size_t e = 0; e < events; ++e) {
+					const input_event& event = buffer[e];
+					if (event.type != EV_KEY) continue; // and event.type != EV_REL))
+					ReadData readData {
+						makeTrigger(index, event.code),
+						event.type,
+						event.value,
+						monotonic ? event.input_event_sec * 1000000ll + event.input_event_usec : now()
+					};
+					if (queue.push(readData))
+						queued = true;
+					else
+						++dropped;
+				}
+				// A short read means the device is drained.
+				if (events < READ_EVENTS) break;
+			}
 		}
+
+		if (queued)
+			eventfd_write(wakeFd, 1);
 	}
 }
+
+int64_t Reader::now() {
+	timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return time.tv_sec * 1000000ll + time.tv_nsec / 1000;
+}
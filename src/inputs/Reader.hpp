@@ -21,19 +21,34 @@
  */
 
 #include "Input.hpp"
+#include "utilities/SPSCQueue.hpp"
 #include <linux/input.h>
 #include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <poll.h>
 
 #pragma once
 
 #define DEV_INPUT "/dev/input/by-id/"
 
+/// Number of events read by a single system call.
+#define READ_EVENTS 64
+
+/// Number of events the input thread can keep until the next frame.
+#define INPUT_QUEUE_SIZE 1024
+
+/// Number of presses used for every latency report.
+#define LATENCY_REPORT 100
+
 namespace LEDSpicer::Inputs {
 
 /**
  * LEDSpicer::Inputs::Reader
  *
  * Abstract class with input reader to support user interaction on other plugins.
+ * The input devices are read by a thread that waits on them with epoll and
+ * queues the key events with their time, the plugins pick them on every frame.
  */
 class Reader: public Input {
 
@@ -41,7 +56,7 @@ public:
 
 	Reader(StringUMap& parameters, ItemPtrUMap& inputMaps);
 
-	virtual ~Reader() = default;
+	virtual ~Reader();
 
 	void activate() override;
 
@@ -49,17 +64,48 @@ public:
 
 	void drawConfig() const override;
 
+	/**
+	 * Waits until an input event arrives.
+	 * If the input thread is not running, it just sleeps.
+	 *
+	 * @param timeout maximum time to wait.
+	 * @return true if an input event arrived before the timeout.
+	 */
+	static bool waitForInput(milliseconds timeout);
+
+	/**
+	 * Called when a frame was sent to the devices,
+	 * measures the time from the first press handled on that frame.
+	 */
+	static void reportLatency();
+
 protected:
 
 	struct ListenEventData {
 		int     rCode;
 		uint8_t index;
+		/// True if the device stamps the events with the monotonic clock.
+		bool    monotonic;
 	};
 
 	struct ReadData {
-		string trigger;
+		/// Device index and event code, see makeTrigger.
+		uint32_t trigger;
 		uint16_t type;
 		int value;
+		/// Event time, monotonic clock microseconds.
+		int64_t time;
+	};
+
+	struct Trigger {
+		/// Device index and event code, see makeTrigger.
+		uint32_t code;
+		/// Trigger as written on the configuration, key on itemsUMap.
+		const string* name;
+		/// Element or Group mapped.
+		Items* item;
+		/// Controlled item id.
+		uint16_t id;
 	};
 
 	/// Detailed poll of events.
@@ -73,11 +119,79 @@ protected:
 	 */
 	static unordered_map<string, ListenEventData> listenEvents;
 
+	/// This reader triggers sorted by code.
+	vector<Trigger> triggers;
+
+	/// Events read by the input thread waiting for the next frame.
+	static SPSCQueue<ReadData, INPUT_QUEUE_SIZE> queue;
+
+	/// Input thread.
+	static std::thread inputThread;
+
+	static int
+		/// Waits on the input devices and stopFd.
+		epollFd,
+		/// Stops the input thread.
+		stopFd,
+		/// Signaled by the input thread when events are queued.
+		wakeFd;
+
+	/// Events lost because the queue was full.
+	static std::atomic<uint32_t> dropped;
+
+	/// Time of the first press handled on this frame, zero if none.
+	static int64_t pressTime;
+
+	/// Latency statistics in microseconds.
+	static int64_t
+		latencyTotal,
+		latencyMax;
+
+	/// Presses measured.
+	static uint16_t latencyCount;
+
+	/// Number of readers alive, the last one releases the input thread.
+	static uint16_t instances;
+
+	/**
+	 * Starts the input thread with the open devices, restarting it if is running.
+	 */
+	static void startInputThread();
+
+	/**
+	 * Stops and joins the input thread.
+	 */
+	static void stopInputThread();
+
+	/**
+	 * Input thread loop.
+	 */
+	static void inputLoop();
+
 	/**
-	 * Reads all the events.
+	 * @return the monotonic clock in microseconds.
+	 */
+	static int64_t now();
+
+	/**
+	 * Picks the events queued by the input thread.
 	 */
 	void readAll();
 
+	/**
+	 * Finds the trigger mapped to an event.
+	 * @param code the event trigger.
+	 * @return the trigger or nullptr if is not mapped by this reader.
+	 */
+	const Trigger* findTrigger(uint32_t code) const;
+
+	/**
+	 * @param index the listen event index.
+	 * @param code the event code.
+	 * @return the integer form of the trigger.
+	 */
+	static uint32_t makeTrigger(uint8_t index, uint16_t code);
+
 };
 
 } // namespace
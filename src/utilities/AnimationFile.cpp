@@ -0,0 +1,193 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      AnimationFile.cpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "AnimationFile.hpp"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+
+using namespace LEDSpicer::Utilities;
+
+AnimationFile::AnimationFile(const string& filename) : filename(filename) {
+
+	int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd == -1)
+		throw Error("Unable to open animation ") << filename << " " << strerror(errno);
+	struct stat info;
+	if (fstat(fd, &info) == -1 or info.st_size < HEADER_SIZE) {
+		::close(fd);
+		throw Error("Invalid animation ") << filename;
+	}
+	size = info.st_size;
+	void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (mapped == MAP_FAILED)
+		throw Error("Unable to map animation ") << filename << " " << strerror(errno);
+	data = static_cast<const uint8_t*>(mapped);
+	// Frames are read in order.
+	madvise(mapped, size, MADV_SEQUENTIAL);
+
+	frames   = read32(8);
+	elements = read16(6);
+	fps      = data[5];
+	bool valid =
+		std::memcmp(data, ANIMATION_MAGIC, 4) == 0 and
+		data[4] == ANIMATION_VERSION and
+		frames and
+		HEADER_SIZE + (frames + 1ull) * 4 <= size and
+		read32(HEADER_SIZE + frames * 4ull) == size;
+	for (uint32_t f = 0; valid and f < frames; ++f)
+		valid = check(f);
+	if (not valid) {
+		munmap(mapped, size);
+		data = nullptr;
+		throw Error("Invalid animation ") << filename;
+	}
+	LogDebug("Animation " + filename + " mapped, " + to_string(frames) + " frames of " + to_string(elements) + " elements");
+}
+
+AnimationFile::~AnimationFile() {
+	if (data)
+		munmap(const_cast<uint8_t*>(data), size);
+}
+
+const string& AnimationFile::getFilename() const {
+	return filename;
+}
+
+uint32_t AnimationFile::getFrames() const {
+	return frames;
+}
+
+uint16_t AnimationFile::getElements() const {
+	return elements;
+}
+
+uint8_t AnimationFile::getFPS() const {
+	return fps;
+}
+
+uint16_t AnimationFile::decode(uint32_t frame, uint8_t* rgb) const {
+	size_t position = read32(HEADER_SIZE + frame * 4);
+	auto encoding = static_cast<Encodings>(data[position]);
+	uint16_t count = read16(position + 1);
+	const uint8_t* colors = data + position + FRAME_HEADER_SIZE;
+	if (encoding == Encodings::Raw) {
+		std::memcpy(rgb, colors, count * CHANNELS);
+		return count;
+	}
+	for (uint16_t e = 0; e < count; colors += CHANNELS + 1) {
+		for (uint8_t run = colors[0]; run; --run, ++e, rgb += CHANNELS)
+			std::memcpy(rgb, colors + 1, CHANNELS);
+	}
+	return count;
+}
+
+void AnimationFile::write(const string& filename, const vector<vector<uint8_t>>& frames, uint8_t fps) {
+
+	string header(ANIMATION_MAGIC), index, body, rle;
+	header.push_back(ANIMATION_VERSION);
+	header.push_back(fps);
+	size_t biggest = 0;
+	for (auto& frame : frames)
+		biggest = std::max(biggest, frame.size() / CHANNELS);
+	if (frames.empty() or biggest > UINT16_MAX)
+		throw Error("Invalid animation size for ") << filename;
+	appendNumber(header, biggest, 2);
+	appendNumber(header, frames.size(), 4);
+	appendNumber(header, 0, 4);
+
+	size_t start = HEADER_SIZE + (frames.size() + 1) * 4;
+	for (auto& frame : frames) {
+		appendNumber(index, start + body.size(), 4);
+		uint16_t count = frame.size() / CHANNELS;
+		rle.clear();
+		for (uint16_t e = 0; e < count;) {
+			uint16_t run = 1;
+			while (
+				e + run < count and run < UINT8_MAX and
+				std::memcmp(&frame[e * CHANNELS], &frame[(e + run) * CHANNELS], CHANNELS) == 0
+			)
+				++run;
+			rle.push_back(static_cast<char>(run));
+			rle.append(reinterpret_cast<const char*>(&frame[e * CHANNELS]), CHANNELS);
+			e += run;
+		}
+		bool raw = rle.size() >= count * CHANNELS;
+		body.push_back(static_cast<char>(raw ? Encodings::Raw : Encodings::RLE));
+		appendNumber(body, count, 2);
+		if (raw)
+			body.append(reinterpret_cast<const char*>(frame.data()), count * CHANNELS);
+		else
+			body.append(rle);
+	}
+	if (start + body.size() > UINT32_MAX)
+		throw Error("Animation too big for ") << filename;
+	appendNumber(index, start + body.size(), 4);
+
+	std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+	file << header << index << body;
+	if (not file.good())
+		throw Error("Unable to write animation ") << filename;
+}
+
+uint16_t AnimationFile::read16(size_t position) const {
+	return data[position] | data[position + 1] << 8;
+}
+
+uint32_t AnimationFile::read32(size_t position) const {
+	return
+		data[position] |
+		data[position + 1] << 8 |
+		data[position + 2] << 16 |
+		static_cast<uint32_t>(data[position + 3]) << 24;
+}
+
+bool AnimationFile::check(uint32_t frame) const {
+	size_t
+		position = read32(HEADER_SIZE + frame * 4),
+		end      = read32(HEADER_SIZE + (frame + 1) * 4);
+	if (position < HEADER_SIZE + (frames + 1ull) * 4 or position + FRAME_HEADER_SIZE > end or end > size)
+		return false;
+	auto encoding = static_cast<Encodings>(data[position]);
+	uint16_t count = read16(position + 1);
+	if (count > elements)
+		return false;
+	position += FRAME_HEADER_SIZE;
+	if (encoding == Encodings::Raw)
+		return position + count * CHANNELS == end;
+	if (encoding != Encodings::RLE)
+		return false;
+	uint32_t decoded = 0;
+	for (; position + CHANNELS + 1 <= end; position += CHANNELS + 1) {
+		if (not data[position])
+			return false;
+		decoded += data[position];
+	}
+	return position == end and decoded == count;
+}
+
+void AnimationFile::appendNumber(string& output, uint32_t value, uint8_t bytes) {
+	for (uint8_t b = 0; b < bytes; ++b)
+		output.push_back(static_cast<char>((value >> (b * 8)) & 0xFF));
+}
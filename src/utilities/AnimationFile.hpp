@@ -0,0 +1,154 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      AnimationFile.hpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "Error.hpp"
+#include "Log.hpp"
+
+#pragma once
+
+#define ANIMATION_MAGIC   "LSAF"
+#define ANIMATION_VERSION 1
+
+namespace LEDSpicer::Utilities {
+
+/**
+ * LEDSpicer::Utilities::AnimationFile
+ *
+ * Binary animation, memory mapped and decoded one frame at a time.
+ *
+ * Numbers are little endian:
+ * - Header: magic "LSAF", version (uint8), frames per second (uint8), elements of the biggest frame (uint16),
+ *   frames (uint32) and 4 reserved bytes.
+ * - Index: the offset of every frame from the start of the file (uint32) and the file size.
+ * - Frame: encoding (uint8), elements (uint16) and the colors, raw as RGB
+ *   or run length encoded as runs of [count (uint8)][RGB].
+ */
+class AnimationFile {
+
+public:
+
+	enum class Encodings : uint8_t {Raw, RLE};
+
+	/// RGB per element, as stored.
+	static constexpr uint8_t CHANNELS = 3;
+
+	/**
+	 * Maps a file and checks every frame.
+	 * @param filename
+	 * @throws Error if the file cannot be read or is not valid.
+	 */
+	explicit AnimationFile(const string& filename);
+
+	AnimationFile(const AnimationFile&) = delete;
+	AnimationFile& operator=(const AnimationFile&) = delete;
+
+	virtual ~AnimationFile();
+
+	/**
+	 * @return the mapped file.
+	 */
+	const string& getFilename() const;
+
+	/**
+	 * @return the number of frames.
+	 */
+	uint32_t getFrames() const;
+
+	/**
+	 * @return the elements of the biggest frame.
+	 */
+	uint16_t getElements() const;
+
+	/**
+	 * @return the frames per second the animation was made for, 0 if unknown.
+	 */
+	uint8_t getFPS() const;
+
+	/**
+	 * Decodes a frame.
+	 * @param frame
+	 * @param[out] rgb receives RGB for every element, needs room for getElements() elements.
+	 * @return the number of elements on the frame.
+	 */
+	uint16_t decode(uint32_t frame, uint8_t* rgb) const;
+
+	/**
+	 * Writes an animation, every frame is stored raw or run length encoded, whichever is smaller.
+	 * @param filename
+	 * @param frames RGB for every element of every frame.
+	 * @param fps
+	 * @throws Error if the file cannot be written.
+	 */
+	static void write(const string& filename, const vector<vector<uint8_t>>& frames, uint8_t fps);
+
+protected:
+
+	/// Bytes before the index.
+	static constexpr uint8_t HEADER_SIZE = 16;
+
+	/// Bytes before the colors of a frame.
+	static constexpr uint8_t FRAME_HEADER_SIZE = 3;
+
+	string filename;
+
+	/// Mapped file.
+	const uint8_t* data = nullptr;
+
+	/// Mapped size.
+	size_t size = 0;
+
+	uint32_t frames = 0;
+
+	uint16_t elements = 0;
+
+	uint8_t fps = 0;
+
+	/**
+	 * @param position
+	 * @return the number stored at position.
+	 */
+	uint16_t read16(size_t position) const;
+
+	/**
+	 * @param position
+	 * @return the number stored at position.
+	 */
+	uint32_t read32(size_t position) const;
+
+	/**
+	 * Checks that a frame decodes inside its space.
+	 * @param frame
+	 * @return false if not.
+	 */
+	bool check(uint32_t frame) const;
+
+	/**
+	 * Appends a little endian number.
+	 * @param output
+	 * @param value
+	 * @param bytes
+	 */
+	static void appendNumber(string& output, uint32_t value, uint8_t bytes);
+};
+
+} // namespace
@@ -0,0 +1,140 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      AudioLevels.cpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "AudioLevels.hpp"
+#include <cmath>
+
+using namespace LEDSpicer::Utilities;
+
+#ifdef __GNUC__
+/// Vectors, the compiler maps them to SSE, NEON or plain registers.
+typedef int16_t Int16x8  __attribute__((vector_size(16)));
+typedef int32_t Int32x8  __attribute__((vector_size(32)));
+typedef int64_t Int64x8  __attribute__((vector_size(64)));
+typedef float   Floatx8  __attribute__((vector_size(32)));
+typedef double  Doublex8 __attribute__((vector_size(64)));
+#endif
+
+AudioLevels::Levels AudioLevels::measure(const int16_t* samples, size_t frames) {
+#ifdef __GNUC__
+	size_t
+		total = frames * 2,
+		c     = 0;
+	Int32x8 peak = {};
+	Int64x8 sum  = {};
+	for (; c + LANES <= total; c += LANES) {
+		Int16x8 v;
+		std::memcpy(&v, samples + c, sizeof(v));
+		// Wider lanes so -32768 has an absolute value.
+		Int32x8 w = __builtin_convertvector(v, Int32x8);
+		w    = w < 0 ? -w : w;
+		peak = w > peak ? w : peak;
+		sum += __builtin_convertvector(w * w, Int64x8);
+	}
+	int32_t peaks[LANES];
+	int64_t squares[LANES];
+	std::memcpy(peaks, &peak, sizeof(peaks));
+	std::memcpy(squares, &sum, sizeof(squares));
+	for (; c < total; ++c) {
+		int32_t w = std::abs(static_cast<int32_t>(samples[c]));
+		peaks[c % LANES]    = std::max(peaks[c % LANES], w);
+		squares[c % LANES] += w * w;
+	}
+	return combine(peaks, squares, frames, S16_FULL_SCALE);
+#else
+	return measureScalar(samples, frames);
+#endif
+}
+
+AudioLevels::Levels AudioLevels::measure(const float* samples, size_t frames) {
+#ifdef __GNUC__
+	size_t
+		total = frames * 2,
+		c     = 0;
+	Floatx8  peak = {};
+	Doublex8 sum  = {};
+	for (; c + LANES <= total; c += LANES) {
+		Floatx8 v;
+		std::memcpy(&v, samples + c, sizeof(v));
+		v    = v < 0 ? -v : v;
+		peak = v > peak ? v : peak;
+		// Squares of floats are exact as doubles.
+		Doublex8 d = __builtin_convertvector(v, Doublex8);
+		sum += d * d;
+	}
+	float  peaks[LANES];
+	double squares[LANES];
+	std::memcpy(peaks, &peak, sizeof(peaks));
+	std::memcpy(squares, &sum, sizeof(squares));
+	for (; c < total; ++c) {
+		float v = std::fabs(samples[c]);
+		peaks[c % LANES]    = std::max(peaks[c % LANES], v);
+		squares[c % LANES] += static_cast<double>(v) * v;
+	}
+	return combine(peaks, squares, frames, 1);
+#else
+	return measureScalar(samples, frames);
+#endif
+}
+
+AudioLevels::Levels AudioLevels::measureScalar(const int16_t* samples, size_t frames) {
+	int32_t peaks[LANES]   = {};
+	int64_t squares[LANES] = {};
+	for (size_t c = 0, total = frames * 2; c < total; ++c) {
+		int32_t w = std::abs(static_cast<int32_t>(samples[c]));
+		peaks[c % LANES]    = std::max(peaks[c % LANES], w);
+		squares[c % LANES] += w * w;
+	}
+	return combine(peaks, squares, frames, S16_FULL_SCALE);
+}
+
+AudioLevels::Levels AudioLevels::measureScalar(const float* samples, size_t frames) {
+	float  peaks[LANES]   = {};
+	double squares[LANES] = {};
+	for (size_t c = 0, total = frames * 2; c < total; ++c) {
+		float v = std::fabs(samples[c]);
+		peaks[c % LANES]    = std::max(peaks[c % LANES], v);
+		squares[c % LANES] += static_cast<double>(v) * v;
+	}
+	return combine(peaks, squares, frames, 1);
+}
+
+template <typename P, typename S>
+AudioLevels::Levels AudioLevels::combine(const P* peaks, const S* squares, size_t frames, float scale) {
+	Levels levels;
+	if (not frames)
+		return levels;
+	P peakL = 0, peakR = 0;
+	S sumL  = 0, sumR  = 0;
+	for (uint8_t l = 0; l < LANES; l += 2) {
+		peakL = std::max(peakL, peaks[l]);
+		peakR = std::max(peakR, peaks[l + 1]);
+		sumL += squares[l];
+		sumR += squares[l + 1];
+	}
+	levels.peakL = static_cast<float>(peakL) / scale;
+	levels.peakR = static_cast<float>(peakR) / scale;
+	levels.rmsL  = std::sqrt(static_cast<double>(sumL) / frames) / scale;
+	levels.rmsR  = std::sqrt(static_cast<double>(sumR) / frames) / scale;
+	return levels;
+}
@@ -0,0 +1,100 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      AudioLevels.hpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "Defaults.hpp"
+
+#pragma once
+
+/// 16 bits sample value measured as 1.
+#define S16_FULL_SCALE 32767.0f
+
+namespace LEDSpicer::Utilities {
+
+/**
+ * LEDSpicer::Utilities::AudioLevels
+ *
+ * Peak and RMS of interleaved stereo samples.
+ * The samples are walked in vectors of 8 without deinterleaving, even lanes are left and odd lanes right,
+ * the scalar versions keep the same lanes so both give the same result to the last bit.
+ */
+class AudioLevels {
+
+public:
+
+	/// Levels per channel, full scale is 1.
+	struct Levels {
+		float
+			peakL = 0,
+			peakR = 0,
+			rmsL  = 0,
+			rmsR  = 0;
+	};
+
+	/**
+	 * @param samples interleaved left and right.
+	 * @param frames number of samples per channel.
+	 * @return the levels.
+	 */
+	static Levels measure(const int16_t* samples, size_t frames);
+
+	/**
+	 * @param samples interleaved left and right.
+	 * @param frames number of samples per channel.
+	 * @return the levels.
+	 */
+	static Levels measure(const float* samples, size_t frames);
+
+	/**
+	 * Same as measure without vectors.
+	 * @param samples
+	 * @param frames
+	 * @return the levels.
+	 */
+	static Levels measureScalar(const int16_t* samples, size_t frames);
+
+	/**
+	 * Same as measure without vectors.
+	 * @param samples
+	 * @param frames
+	 * @return the levels.
+	 */
+	static Levels measureScalar(const float* samples, size_t frames);
+
+protected:
+
+	/// Samples per vector.
+	static constexpr uint8_t LANES = 8;
+
+	/**
+	 * Combines the lanes into the channels.
+	 * @param peaks highest absolute value per lane.
+	 * @param squares sum of squares per lane.
+	 * @param frames
+	 * @param scale full scale value.
+	 * @return the levels.
+	 */
+	template <typename P, typename S>
+	static Levels combine(const P* peaks, const S* squares, size_t frames, float scale);
+};
+
+} // namespace
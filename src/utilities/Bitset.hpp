@@ -0,0 +1,162 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      Bitset.hpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Defaults.hpp"
+
+#pragma once
+
+namespace LEDSpicer::Utilities {
+
+/**
+ * LEDSpicer::Utilities::Bitset
+ *
+ * Resizable set of small ids stored in 64 bit words.
+ * Operations between sets work on whole words, the shorter set decides the range.
+ */
+class Bitset {
+
+public:
+
+	Bitset() = default;
+
+	/**
+	 * @param bits initial size.
+	 */
+	explicit Bitset(size_t bits) {
+		resize(bits);
+	}
+
+	/**
+	 * Changes the size, new bits are off.
+	 * @param bits
+	 */
+	void resize(size_t bits) {
+		words.resize((bits + 63) / 64, 0);
+		// Bits over the new size must read as off if the set grows again.
+		if (bits % 64)
+			words.back() &= (uint64_t(1) << (bits % 64)) - 1;
+		this->bits = bits;
+	}
+
+	/**
+	 * @return the number of bits.
+	 */
+	size_t size() const {
+		return bits;
+	}
+
+	/**
+	 * @param bit
+	 * @return true if the bit is on.
+	 */
+	bool test(size_t bit) const {
+		return bit < bits and (words[bit / 64] >> (bit % 64)) & 1;
+	}
+
+	/**
+	 * Turns a bit on, growing the set if needed.
+	 * @param bit
+	 */
+	void set(size_t bit) {
+		if (bit >= bits)
+			resize(bit + 1);
+		words[bit / 64] |= uint64_t(1) << (bit % 64);
+	}
+
+	/**
+	 * Turns a bit off.
+	 * @param bit
+	 */
+	void reset(size_t bit) {
+		if (bit < bits)
+			words[bit / 64] &= ~(uint64_t(1) << (bit % 64));
+	}
+
+	/**
+	 * Turns on the bits that are on in other.
+	 * @param other
+	 */
+	void set(const Bitset& other) {
+		size_t total = std::min(words.size(), other.words.size());
+		for (size_t w = 0; w < total; ++w)
+			words[w] |= other.words[w];
+	}
+
+	/**
+	 * Turns off the bits that are on in other.
+	 * @param other
+	 */
+	void reset(const Bitset& other) {
+		size_t total = std::min(words.size(), other.words.size());
+		for (size_t w = 0; w < total; ++w)
+			words[w] &= ~other.words[w];
+	}
+
+	/**
+	 * Turns off every bit.
+	 */
+	void clear() {
+		std::fill(words.begin(), words.end(), 0);
+	}
+
+	/**
+	 * @return true if any bit is on.
+	 */
+	bool any() const {
+		for (uint64_t word : words)
+			if (word)
+				return true;
+		return false;
+	}
+
+	/**
+	 * @return the number of bits on.
+	 */
+	size_t count() const {
+		size_t total = 0;
+		for (uint64_t word : words)
+			total += __builtin_popcountll(word);
+		return total;
+	}
+
+	/**
+	 * Calls function with every bit on, in order.
+	 * @param function receives the bit number.
+	 */
+	template <typename F>
+	void forEach(F function) const {
+		for (size_t w = 0; w < words.size(); ++w) {
+			for (uint64_t word = words[w]; word; word &= word - 1)
+				function(w * 64 + __builtin_ctzll(word));
+		}
+	}
+
+protected:
+
+	/// Bits, 64 per word.
+	vector<uint64_t> words;
+
+	/// Number of bits.
+	size_t bits = 0;
+};
+
+} // namespace
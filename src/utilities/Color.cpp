@@ -21,6 +21,7 @@
  */
 
 #include "Color.hpp"
+#include "RandomGenerator.hpp"
 
 using namespace LEDSpicer::Utilities;
 
@@ -336,7 +337,7 @@ string Color::getName() const {
 
 const Color& Color::getColor(const string& color) {
 	if (hasColor(color))       return colors[color];
-	if (color == Color_Random) return *randomColors[std::rand() / ((RAND_MAX + 1u) / randomColors.size())];
+	if (color == Color_Random) return *randomColors[RandomGenerator::shared().below(randomColors.size())];
 	if (color == Color_On)     return On;
 	if (color == Color_Off)    return Off;
 	throw Error("Unknown color ") << color;
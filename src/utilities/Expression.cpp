@@ -0,0 +1,471 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      Expression.cpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "Expression.hpp"
+#include <cmath>
+#include <cctype>
+
+using namespace LEDSpicer::Utilities;
+
+Expression::Expression(const string& source, uint32_t seed) :
+	source(source),
+	generator(seed),
+	seed(seed)
+{
+	parseComparison();
+	while (position < source.size() and std::isspace(source[position]))
+		++position;
+	if (position < source.size())
+		throw Error("Unexpected '") << source.substr(position) << "' in expression " << source;
+	code.shrink_to_fit();
+	constants.shrink_to_fit();
+}
+
+void Expression::evaluate(const Inputs& inputs, vector<float>& output) {
+
+	const size_t elements = output.size();
+	if (not elements)
+		return;
+	stack.resize(depth * elements);
+
+	float* const base = stack.data();
+	float* top = base;
+
+	const auto push = [&](auto value) {
+		for (size_t e = 0; e < elements; ++e)
+			top[e] = value(e);
+		top += elements;
+	};
+	const auto unary = [&](auto function) {
+		float* __restrict a = top - elements;
+		for (size_t e = 0; e < elements; ++e)
+			a[e] = function(a[e]);
+	};
+	const auto binary = [&](auto function) {
+		top -= elements;
+		float* __restrict a = top - elements;
+		const float* __restrict b = top;
+		for (size_t e = 0; e < elements; ++e)
+			a[e] = function(a[e], b[e]);
+	};
+	const auto ternary = [&](auto function) {
+		top -= 2 * elements;
+		float* __restrict a = top - elements;
+		const float
+			* __restrict b = top,
+			* __restrict c = top + elements;
+		for (size_t e = 0; e < elements; ++e)
+			a[e] = function(a[e], b[e], c[e]);
+	};
+
+	const float
+		size  = elements,
+		scale = elements > 1 ? 1.f / (elements - 1) : 0;
+
+	for (const Instruction& instruction : code) {
+		switch (instruction.op) {
+		case Ops::Constant: {
+			const float value = constants[instruction.argument];
+			push([value](size_t) { return value; });
+			break;
+		}
+		case Ops::Index:
+			push([](size_t e) { return static_cast<float>(e); });
+			break;
+		case Ops::Size:
+			push([size](size_t) { return size; });
+			break;
+		case Ops::Position:
+			push([scale](size_t e) { return e * scale; });
+			break;
+		case Ops::Time:
+			push([&inputs](size_t) { return inputs.time; });
+			break;
+		case Ops::Frame:
+			push([&inputs](size_t) { return inputs.frame; });
+			break;
+		case Ops::Audio:
+			push([&inputs](size_t) { return inputs.audio; });
+			break;
+		case Ops::Rand:
+			push([this](size_t) { return generator.next() * (1.f / 4294967296.f); });
+			break;
+		case Ops::Negate:
+			unary([](float a) { return -a; });
+			break;
+		case Ops::Sin:
+			unary([](float a) { return std::sin(a); });
+			break;
+		case Ops::Cos:
+			unary([](float a) { return std::cos(a); });
+			break;
+		case Ops::Abs:
+			unary([](float a) { return std::fabs(a); });
+			break;
+		case Ops::Floor:
+			unary([](float a) { return std::floor(a); });
+			break;
+		case Ops::Fract:
+			unary([](float a) { return a - std::floor(a); });
+			break;
+		case Ops::Sqrt:
+			unary([](float a) { return std::sqrt(a); });
+			break;
+		case Ops::Noise:
+			unary([this](float a) { return noise(a); });
+			break;
+		case Ops::Add:
+			binary([](float a, float b) { return a + b; });
+			break;
+		case Ops::Subtract:
+			binary([](float a, float b) { return a - b; });
+			break;
+		case Ops::Multiply:
+			binary([](float a, float b) { return a * b; });
+			break;
+		case Ops::Divide:
+			binary([](float a, float b) { return a / b; });
+			break;
+		case Ops::Modulo:
+			binary([](float a, float b) { return b ? a - b * std::floor(a / b) : 0.f; });
+			break;
+		case Ops::Power:
+			binary([](float a, float b) { return std::pow(a, b); });
+			break;
+		case Ops::Min:
+			binary([](float a, float b) { return std::fmin(a, b); });
+			break;
+		case Ops::Max:
+			binary([](float a, float b) { return std::fmax(a, b); });
+			break;
+		case Ops::Step:
+			binary([](float a, float b) { return b < a ? 0.f : 1.f; });
+			break;
+		case Ops::Less:
+			binary([](float a, float b) { return a < b ? 1.f : 0.f; });
+			break;
+		case Ops::LessEqual:
+			binary([](float a, float b) { return a <= b ? 1.f : 0.f; });
+			break;
+		case Ops::Greater:
+			binary([](float a, float b) { return a > b ? 1.f : 0.f; });
+			break;
+		case Ops::GreaterEqual:
+			binary([](float a, float b) { return a >= b ? 1.f : 0.f; });
+			break;
+		case Ops::Clamp:
+			ternary([](float a, float b, float c) { return std::fmin(std::fmax(a, b), c); });
+			break;
+		case Ops::Mix:
+			ternary([](float a, float b, float c) { return a + (b - a) * c; });
+			break;
+		}
+	}
+	std::copy(base, base + elements, output.begin());
+}
+
+const string& Expression::getSource() const {
+	return source;
+}
+
+size_t Expression::getSize() const {
+	return code.size();
+}
+
+void Expression::parseComparison() {
+	parseAdditive();
+	while (true) {
+		if (accept('<')) {
+			Ops op = accept('=') ? Ops::LessEqual : Ops::Less;
+			parseAdditive();
+			emit(op);
+		}
+		else if (accept('>')) {
+			Ops op = accept('=') ? Ops::GreaterEqual : Ops::Greater;
+			parseAdditive();
+			emit(op);
+		}
+		else {
+			return;
+		}
+	}
+}
+
+void Expression::parseAdditive() {
+	parseTerm();
+	while (true) {
+		if (accept('+')) {
+			parseTerm();
+			emit(Ops::Add);
+		}
+		else if (accept('-')) {
+			parseTerm();
+			emit(Ops::Subtract);
+		}
+		else {
+			return;
+		}
+	}
+}
+
+void Expression::parseTerm() {
+	parseUnary();
+	while (true) {
+		if (accept('*')) {
+			parseUnary();
+			emit(Ops::Multiply);
+		}
+		else if (accept('/')) {
+			parseUnary();
+			emit(Ops::Divide);
+		}
+		else if (accept('%')) {
+			parseUnary();
+			emit(Ops::Modulo);
+		}
+		else {
+			return;
+		}
+	}
+}
+
+void Expression::parseUnary() {
+	if (accept('-')) {
+		parseUnary();
+		emit(Ops::Negate);
+	}
+	else if (accept('+')) {
+		parseUnary();
+	}
+	else {
+		parsePower();
+	}
+}
+
+void Expression::parsePower() {
+	parsePrimary();
+	// Right associative, 2^3^2 is 2^9.
+	if (accept('^')) {
+		parseUnary();
+		emit(Ops::Power);
+	}
+}
+
+void Expression::parsePrimary() {
+
+	if (accept('(')) {
+		parseComparison();
+		if (not accept(')'))
+			throw Error("Missing ')' in expression ") << source;
+		return;
+	}
+
+	if (position == source.size())
+		throw Error("Unexpected end of expression ") << source;
+
+	const char c = source[position];
+	if (std::isdigit(c) or c == '.') {
+		const char* start = source.c_str() + position;
+		char* end = nullptr;
+		float value = std::strtof(start, &end);
+		if (end == start)
+			throw Error("Invalid number in expression ") << source;
+		position += end - start;
+		emitConstant(value);
+		return;
+	}
+
+	const string name(readName());
+	if (name.empty())
+		throw Error("Unexpected '") << source.substr(position, 1) << "' in expression " << source;
+
+	static const unordered_map<string, Ops>
+		functions {
+			{"sin",   Ops::Sin},
+			{"cos",   Ops::Cos},
+			{"abs",   Ops::Abs},
+			{"floor", Ops::Floor},
+			{"fract", Ops::Fract},
+			{"sqrt",  Ops::Sqrt},
+			{"noise", Ops::Noise},
+			{"pow",   Ops::Power},
+			{"min",   Ops::Min},
+			{"max",   Ops::Max},
+			{"step",  Ops::Step},
+			{"clamp", Ops::Clamp},
+			{"mix",   Ops::Mix}
+		},
+		variables {
+			{"i",     Ops::Index},
+			{"n",     Ops::Size},
+			{"x",     Ops::Position},
+			{"t",     Ops::Time},
+			{"f",     Ops::Frame},
+			{"audio", Ops::Audio},
+			{"rand",  Ops::Rand}
+		};
+
+	if (accept('(')) {
+		if (not functions.count(name))
+			throw Error("Unknown function ") << name << " in expression " << source;
+		Ops op = functions.at(name);
+		parseArguments(name, arguments(op));
+		emit(op);
+		return;
+	}
+
+	if (name == "pi") {
+		emitConstant(M_PI);
+		return;
+	}
+
+	if (variables.count(name)) {
+		emit(variables.at(name));
+		return;
+	}
+
+	throw Error("Unknown variable ") << name << " in expression " << source;
+}
+
+void Expression::parseArguments(const string& name, uint8_t count) {
+	for (uint8_t c = 0; c < count; ++c) {
+		if (c and not accept(','))
+			throw Error("Function ") << name << " takes " << to_string(count) << " arguments in expression " << source;
+		parseComparison();
+	}
+	if (not accept(')'))
+		throw Error("Function ") << name << " takes " << to_string(count) << " arguments in expression " << source;
+}
+
+bool Expression::accept(char c) {
+	while (position < source.size() and std::isspace(source[position]))
+		++position;
+	if (position < source.size() and source[position] == c) {
+		++position;
+		return true;
+	}
+	return false;
+}
+
+string Expression::readName() {
+	size_t start = position;
+	while (position < source.size() and (std::isalnum(source[position]) or source[position] == '_'))
+		++position;
+	return source.substr(start, position - start);
+}
+
+void Expression::emit(Ops op, uint8_t argument) {
+
+	const uint8_t count = arguments(op);
+
+	// Operations on constants are done once here.
+	if (count and code.size() >= count) {
+		bool folding = true;
+		for (uint8_t c = 1; c <= count; ++c)
+			folding = folding and code[code.size() - c].op == Ops::Constant;
+		if (folding) {
+			// Every constant push has its own constant, in order.
+			float values[3] {};
+			for (uint8_t c = 0; c < count; ++c)
+				values[c] = constants[constants.size() - count + c];
+			code.resize(code.size() - count);
+			constants.resize(constants.size() - count);
+			compileDepth -= count;
+			emitConstant(apply(op, values[0], values[1], values[2]));
+			return;
+		}
+	}
+
+	code.push_back({op, argument});
+	compileDepth = compileDepth + 1 - count;
+	if (compileDepth > EXPRESSION_STACK)
+		throw Error("Expression too complex ") << source;
+	depth = std::max(depth, compileDepth);
+}
+
+void Expression::emitConstant(float value) {
+	if (constants.size() > UINT8_MAX)
+		throw Error("Too many numbers in expression ") << source;
+	constants.push_back(value);
+	emit(Ops::Constant, constants.size() - 1);
+}
+
+float Expression::apply(Ops op, float a, float b, float c) const {
+	switch (op) {
+	case Ops::Negate:       return -a;
+	case Ops::Sin:          return std::sin(a);
+	case Ops::Cos:          return std::cos(a);
+	case Ops::Abs:          return std::fabs(a);
+	case Ops::Floor:        return std::floor(a);
+	case Ops::Fract:        return a - std::floor(a);
+	case Ops::Sqrt:         return std::sqrt(a);
+	case Ops::Noise:        return noise(a);
+	case Ops::Add:          return a + b;
+	case Ops::Subtract:     return a - b;
+	case Ops::Multiply:     return a * b;
+	case Ops::Divide:       return a / b;
+	case Ops::Modulo:       return b ? a - b * std::floor(a / b) : 0.f;
+	case Ops::Power:        return std::pow(a, b);
+	case Ops::Min:          return std::fmin(a, b);
+	case Ops::Max:          return std::fmax(a, b);
+	case Ops::Step:         return b < a ? 0.f : 1.f;
+	case Ops::Less:         return a < b;
+	case Ops::LessEqual:    return a <= b;
+	case Ops::Greater:      return a > b;
+	case Ops::GreaterEqual: return a >= b;
+	case Ops::Clamp:        return std::fmin(std::fmax(a, b), c);
+	case Ops::Mix:          return a + (b - a) * c;
+	default:                return 0;
+	}
+}
+
+float Expression::noise(float value) const {
+
+	if (not std::isfinite(value))
+		return 0;
+	value = std::fmin(std::fmax(value, -1e6f), 1e6f);
+
+	const float cell = std::floor(value);
+	const auto hash = [this](int32_t position) {
+		uint32_t h = static_cast<uint32_t>(position) * 0x9E3779B1 ^ seed;
+		h ^= h >> 16;
+		h *= 0x85EBCA6B;
+		h ^= h >> 13;
+		h *= 0xC2B2AE35;
+		h ^= h >> 16;
+		return h * (1.f / 4294967296.f);
+	};
+
+	const float
+		a = hash(cell),
+		b = hash(cell + 1),
+		s = value - cell;
+	return a + (b - a) * s * s * (3 - 2 * s);
+}
+
+uint8_t Expression::arguments(Ops op) {
+	if (op < Ops::Negate)  return 0;
+	if (op < Ops::Add)     return 1;
+	if (op < Ops::Clamp)   return 2;
+	return 3;
+}
@@ -0,0 +1,205 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      Expression.hpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "Error.hpp"
+#include "RandomGenerator.hpp"
+
+#pragma once
+
+/// Deepest stack an expression can use.
+#define EXPRESSION_STACK 16
+
+namespace LEDSpicer::Utilities {
+
+/**
+ * LEDSpicer::Utilities::Expression
+ *
+ * Small math language compiled into bytecode once and evaluated for a whole group of elements at a time.
+ *
+ * Numbers, + - * / % ^, comparisons (< <= > >= give 0 or 1), parentheses and
+ * the variables:
+ * - i:     element index.
+ * - n:     number of elements.
+ * - x:     element position from 0 to 1.
+ * - t:     seconds since the start.
+ * - f:     frames since the start.
+ * - audio: audio level from 0 to 1.
+ * - rand:  a new random number from 0 to 1 for every element.
+ * - pi
+ * Functions: sin cos abs floor fract sqrt noise (one argument), min max pow step (two), clamp mix (three).
+ * noise is smooth value noise from 0 to 1, the same seed gives the same noise.
+ *
+ * Every instruction runs over all the elements before the next one, so the loops are short and tight.
+ */
+class Expression {
+
+public:
+
+	/// Values that change every evaluation.
+	struct Inputs {
+		float
+			time  = 0,
+			frame = 0,
+			audio = 0;
+	};
+
+	/**
+	 * Compiles an expression.
+	 * @param source
+	 * @param seed for rand and noise.
+	 * @throws Error if the expression is invalid.
+	 */
+	Expression(const string& source, uint32_t seed = 0);
+
+	/**
+	 * Evaluates the expression for every element.
+	 * @param inputs
+	 * @param[out] output one value per element, its size sets the number of elements.
+	 */
+	void evaluate(const Inputs& inputs, vector<float>& output);
+
+	/**
+	 * @return the source.
+	 */
+	const string& getSource() const;
+
+	/**
+	 * @return the number of instructions.
+	 */
+	size_t getSize() const;
+
+protected:
+
+	enum class Ops : uint8_t {
+		// Pushes.
+		Constant, Index, Size, Position, Time, Frame, Audio, Rand,
+		// Unary.
+		Negate, Sin, Cos, Abs, Floor, Fract, Sqrt, Noise,
+		// Binary.
+		Add, Subtract, Multiply, Divide, Modulo, Power, Min, Max, Step, Less, LessEqual, Greater, GreaterEqual,
+		// Ternary.
+		Clamp, Mix
+	};
+
+	struct Instruction {
+		Ops op;
+		/// Index into the constants for Constant.
+		uint8_t argument;
+	};
+
+	/// Source text.
+	string source;
+
+	/// Compiled program.
+	vector<Instruction> code;
+
+	/// Constants used by the program.
+	vector<float> constants;
+
+	/// Deepest stack used by the program.
+	uint8_t depth = 0;
+
+	/// Stack, one row of elements per level.
+	vector<float> stack;
+
+	/// Random numbers for rand.
+	RandomGenerator generator;
+
+	/// Seed for noise.
+	uint32_t seed;
+
+	/// Parser position.
+	size_t position = 0;
+
+	/// Stack depth while compiling.
+	uint8_t compileDepth = 0;
+
+	void parseComparison();
+
+	void parseAdditive();
+
+	void parseTerm();
+
+	void parseUnary();
+
+	void parsePower();
+
+	void parsePrimary();
+
+	/**
+	 * Parses the arguments of a function.
+	 * @param name
+	 * @param count expected number of arguments.
+	 * @throws Error if the number of arguments is wrong.
+	 */
+	void parseArguments(const string& name, uint8_t count);
+
+	/**
+	 * Skips spaces and checks the next character.
+	 * @param c
+	 * @return true if c is next, consuming it.
+	 */
+	bool accept(char c);
+
+	/**
+	 * @return the next letters and digits as a name.
+	 */
+	string readName();
+
+	/**
+	 * Adds an instruction, folding operations on constants.
+	 * @param op
+	 * @param argument
+	 */
+	void emit(Ops op, uint8_t argument = 0);
+
+	/**
+	 * Adds a constant push.
+	 * @param value
+	 */
+	void emitConstant(float value);
+
+	/**
+	 * Applies an operation to a single set of values, used to fold constants.
+	 * @param op
+	 * @param a
+	 * @param b
+	 * @param c
+	 * @return the result.
+	 */
+	float apply(Ops op, float a, float b = 0, float c = 0) const;
+
+	/**
+	 * @param value
+	 * @return smooth noise from 0 to 1.
+	 */
+	float noise(float value) const;
+
+	/**
+	 * @param op
+	 * @return how many values op takes from the stack.
+	 */
+	static uint8_t arguments(Ops op);
+};
+
+} // namespace
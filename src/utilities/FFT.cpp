@@ -0,0 +1,99 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      FFT.cpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "FFT.hpp"
+#include <cmath>
+
+using namespace LEDSpicer::Utilities;
+
+FFT::FFT(size_t size) :
+	samples(size),
+	reversed(size),
+	window(size),
+	twiddleReal(size ? size - 1 : 0),
+	twiddleImaginary(size ? size - 1 : 0),
+	real(size),
+	imaginary(size)
+{
+	if (size < 2 or (size & (size - 1)))
+		throw Error("FFT size must be a power of two, got ") << to_string(size);
+
+	uint8_t bits = __builtin_ctzll(size);
+	for (size_t c = 0; c < size; ++c) {
+		uint32_t r = 0;
+		for (uint8_t b = 0; b < bits; ++b)
+			r |= ((c >> b) & 1) << (bits - 1 - b);
+		reversed[c] = r;
+	}
+
+	float sum = 0;
+	for (size_t c = 0; c < size; ++c) {
+		window[c] = 0.5f - 0.5f * std::cos(2 * M_PI * c / size);
+		sum += window[c];
+	}
+	scale = 2 / sum;
+
+	for (size_t half = 1; half < size; half <<= 1) {
+		for (size_t j = 0; j < half; ++j) {
+			twiddleReal[half - 1 + j]      = std::cos(M_PI * j / half);
+			twiddleImaginary[half - 1 + j] = -std::sin(M_PI * j / half);
+		}
+	}
+}
+
+size_t FFT::size() const {
+	return samples;
+}
+
+void FFT::magnitudes(const float* input, float* output) {
+
+	for (size_t c = 0; c < samples; ++c) {
+		real[reversed[c]]      = input[c] * window[c];
+		imaginary[reversed[c]] = 0;
+	}
+
+	for (size_t half = 1; half < samples; half <<= 1) {
+		const float
+			* __restrict wr = &twiddleReal[half - 1],
+			* __restrict wi = &twiddleImaginary[half - 1];
+		for (size_t block = 0; block < samples; block += half * 2) {
+			float
+				* __restrict ar = &real[block],
+				* __restrict ai = &imaginary[block],
+				* __restrict br = ar + half,
+				* __restrict bi = ai + half;
+			for (size_t j = 0; j < half; ++j) {
+				float
+					tr = br[j] * wr[j] - bi[j] * wi[j],
+					ti = br[j] * wi[j] + bi[j] * wr[j];
+				br[j] = ar[j] - tr;
+				bi[j] = ai[j] - ti;
+				ar[j] += tr;
+				ai[j] += ti;
+			}
+		}
+	}
+
+	for (size_t c = 0; c < samples / 2; ++c)
+		output[c] = std::sqrt(real[c] * real[c] + imaginary[c] * imaginary[c]) * scale;
+}
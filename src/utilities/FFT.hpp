@@ -0,0 +1,87 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      FFT.hpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "Error.hpp"
+
+#pragma once
+
+namespace LEDSpicer::Utilities {
+
+/**
+ * LEDSpicer::Utilities::FFT
+ *
+ * Radix-2 fast Fourier transform over real samples.
+ * Tables are computed once, real and imaginary parts are kept in separate arrays
+ * and every stage reads its twiddles contiguously so the butterflies vectorize.
+ */
+class FFT {
+
+public:
+
+	/**
+	 * @param size number of samples, a power of two.
+	 * @throws Error if the size is not a power of two.
+	 */
+	explicit FFT(size_t size);
+
+	virtual ~FFT() = default;
+
+	/**
+	 * @return the number of samples.
+	 */
+	size_t size() const;
+
+	/**
+	 * Calculates the magnitudes of the samples with a Hann window.
+	 *
+	 * @param samples size samples.
+	 * @param[out] magnitudes size / 2 values, a full scale sine is 1.
+	 */
+	void magnitudes(const float* samples, float* magnitudes);
+
+protected:
+
+	/// Number of samples.
+	size_t samples;
+
+	/// Position of every sample after the bit reversal.
+	vector<uint32_t> reversed;
+
+	/// Hann window.
+	vector<float> window;
+
+	/// Twiddles of every stage, the stage of half h starts at h - 1.
+	vector<float>
+		twiddleReal,
+		twiddleImaginary;
+
+	/// Work buffers.
+	vector<float>
+		real,
+		imaginary;
+
+	/// Scales the magnitudes so a full scale sine is 1.
+	float scale = 0;
+};
+
+} // namespace
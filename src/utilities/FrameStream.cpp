@@ -0,0 +1,264 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      FrameStream.cpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FrameStream.hpp"
+#include "Utility.hpp"
+#include <sys/stat.h>
+
+using namespace LEDSpicer::Utilities;
+
+/// Unchanged bytes shorter than a run header are cheaper to send inside the run.
+#define RUN_HEADER_SIZE 4
+
+FrameStream::FrameStream(const string& path, uint8_t fps, const vector<uid_t>& allowedUsers) :
+	path(path),
+	fps(fps ? fps : 1),
+	allowedUsers(allowedUsers)
+{
+	sockaddr_un address {};
+	if (path.empty() or path.size() >= sizeof(address.sun_path))
+		throw Error("Invalid stream socket path ") << path;
+	address.sun_family = AF_UNIX;
+	path.copy(address.sun_path, path.size());
+
+	socketFB = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (socketFB == -1)
+		throw Error("Failed to create stream socket ") << strerror(errno);
+
+	// Remove the file left by a previous run.
+	::unlink(path.c_str());
+	if (
+		::bind(socketFB, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1 or
+		::listen(socketFB, STREAM_SUBSCRIBERS) == -1
+	) {
+		string error(strerror(errno));
+		::close(socketFB);
+		socketFB = -1;
+		throw Error("Failed to bind stream to ") << path << " " << error;
+	}
+	// Credentials do the access control, so everyone can reach the socket.
+	if (not allowedUsers.empty())
+		chmod(path.c_str(), 0666);
+	LogInfo("Streaming frames on " + path);
+}
+
+FrameStream::~FrameStream() {
+	for (auto& s : subscribers)
+		::close(s.fd);
+	if (socketFB != -1) {
+		::close(socketFB);
+		::unlink(path.c_str());
+	}
+}
+
+void FrameStream::setMetadata(const string& metadata) {
+	this->metadata = metadata;
+	// Everyone connected gets the new layout.
+	for (auto& s : subscribers) {
+		s.pendingMetadata = true;
+		s.last.clear();
+	}
+}
+
+void FrameStream::publish(const vector<uint8_t>& frame) noexcept {
+
+	acceptSubscribers();
+	++frameNumber;
+
+	for (auto s = subscribers.begin(); s != subscribers.end();) {
+
+		int8_t result = readRequest(*s) ? 1 : -1;
+
+		if (result > 0 and s->pendingMetadata) {
+			packet.assign(1, STREAM_METADATA);
+			packet.append(metadata);
+			result = sendPacket(*s, packet);
+			if (result > 0)
+				s->pendingMetadata = false;
+		}
+
+		if (result > 0 and not s->pendingMetadata and ++s->skipped >= s->divider) {
+			bool keyframe = s->last.size() != frame.size() or s->sinceKeyframe >= STREAM_KEYFRAME_INTERVAL;
+			if (not keyframe) {
+				packet.assign(1, STREAM_DELTA);
+				appendNumber(packet, frameNumber, 4);
+				// A delta bigger than the frame is a waste.
+				keyframe = not encodeDelta(s->last, frame, packet, frame.size());
+			}
+			if (keyframe) {
+				packet.assign(1, STREAM_KEYFRAME);
+				appendNumber(packet, frameNumber, 4);
+				packet.append(reinterpret_cast<const char*>(frame.data()), frame.size());
+			}
+			// Dropped frames are retried on the next one.
+			result = sendPacket(*s, packet);
+			if (result > 0) {
+				s->last          = frame;
+				s->skipped       = 0;
+				s->sinceKeyframe = keyframe ? 0 : s->sinceKeyframe + 1;
+			}
+		}
+
+		if (result < 0) {
+			LogDebug("Frame stream subscriber disconnected");
+			::close(s->fd);
+			s = subscribers.erase(s);
+			continue;
+		}
+		++s;
+	}
+}
+
+size_t FrameStream::getSubscribers() const {
+	return subscribers.size();
+}
+
+const string& FrameStream::getPath() const {
+	return path;
+}
+
+bool FrameStream::encodeDelta(
+	const vector<uint8_t>& previous,
+	const vector<uint8_t>& current,
+	string& output,
+	size_t limit
+) {
+	if (previous.size() != current.size())
+		return false;
+
+	size_t
+		position = 0,
+		size     = current.size();
+
+	while (true) {
+		size_t start = position;
+		while (start < size and previous[start] == current[start])
+			++start;
+		if (start == size)
+			return true;
+
+		// Empty runs cover long unchanged areas.
+		for (; start - position > UINT16_MAX; position += UINT16_MAX) {
+			appendNumber(output, UINT16_MAX, 2);
+			appendNumber(output, 0, 2);
+		}
+
+		size_t end = start + 1;
+		for (size_t i = end; i < size and i - start < UINT16_MAX; ++i) {
+			if (previous[i] != current[i])
+				end = i + 1;
+			else if (i - end >= RUN_HEADER_SIZE)
+				break;
+		}
+
+		appendNumber(output, start - position, 2);
+		appendNumber(output, end - start, 2);
+		for (size_t i = start; i < end; ++i)
+			output.push_back(static_cast<char>(previous[i] ^ current[i]));
+		if (output.size() > limit)
+			return false;
+		position = end;
+	}
+}
+
+bool FrameStream::applyDelta(vector<uint8_t>& frame, const uint8_t* delta, size_t size) {
+	size_t
+		position = 0,
+		index    = 0;
+	while (index + RUN_HEADER_SIZE <= size) {
+		size_t
+			skip   = delta[index]     | delta[index + 1] << 8,
+			length = delta[index + 2] | delta[index + 3] << 8;
+		index    += RUN_HEADER_SIZE;
+		position += skip;
+		if (position + length > frame.size() or index + length > size)
+			return false;
+		for (size_t i = 0; i < length; ++i)
+			frame[position++] ^= delta[index++];
+	}
+	return index == size;
+}
+
+void FrameStream::acceptSubscribers() noexcept {
+	while (true) {
+		int client = accept4(socketFB, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if (client < 0)
+			return;
+		ucred credentials {};
+		socklen_t size = sizeof(credentials);
+		if (
+			not allowedUsers.empty() and (
+				getsockopt(client, SOL_SOCKET, SO_PEERCRED, &credentials, &size) == -1 or
+				std::find(allowedUsers.begin(), allowedUsers.end(), credentials.uid) == allowedUsers.end()
+			)
+		) {
+			LogNotice("Frame stream subscription from user " + to_string(credentials.uid) + " rejected");
+			::close(client);
+			continue;
+		}
+		if (subscribers.size() >= STREAM_SUBSCRIBERS) {
+			LogNotice("Frame stream subscription rejected, too many subscribers");
+			::close(client);
+			continue;
+		}
+		LogDebug("Frame stream subscriber connected");
+		subscribers.push_back(Subscriber{client, 1, 0, 0, true, {}});
+	}
+}
+
+bool FrameStream::readRequest(Subscriber& subscriber) noexcept {
+	char buffer[BUFFER_SIZE];
+	while (true) {
+		ssize_t r = recv(subscriber.fd, buffer, sizeof(buffer) - 1, MSG_DONTWAIT);
+		if (r == 0)
+			return false;
+		if (r < 0)
+			return errno == EAGAIN or errno == EWOULDBLOCK or errno == EINTR;
+		string request(buffer, r);
+		Utility::trim(request);
+		try {
+			int requested = Utility::parseNumber(request, "Invalid frame rate");
+			subscriber.divider = requested > 0 and requested < fps ? fps / requested : 1;
+			subscriber.skipped = 0;
+			LogDebug("Frame stream subscriber requested " + to_string(fps / subscriber.divider) + " fps");
+		}
+		catch (Error& e) {
+			LogNotice("Frame stream " + e.getMessage() + " " + request);
+		}
+	}
+}
+
+int8_t FrameStream::sendPacket(const Subscriber& subscriber, const string& data) noexcept {
+	ssize_t r = ::send(subscriber.fd, data.data(), data.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+	if (r == static_cast<ssize_t>(data.size()))
+		return 1;
+	if (r < 0 and (errno == EAGAIN or errno == EWOULDBLOCK or errno == ENOBUFS or errno == EINTR))
+		return 0;
+	if (r < 0 and errno == EMSGSIZE)
+		LogWarning("Frame stream packet of " + to_string(data.size()) + " bytes is too big");
+	return -1;
+}
+
+void FrameStream::appendNumber(string& output, uint32_t value, uint8_t bytes) {
+	for (uint8_t b = 0; b < bytes; ++b)
+		output.push_back(static_cast<char>((value >> (b * 8)) & 0xFF));
+}
@@ -0,0 +1,202 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      FrameStream.hpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <fcntl.h>
+
+#include "Error.hpp"
+#include "Log.hpp"
+
+#pragma once
+
+/// Metadata packet, sent once after subscribing.
+#define STREAM_METADATA 'M'
+/// Full frame packet.
+#define STREAM_KEYFRAME 'K'
+/// Frame packet with the changes against the previous frame sent.
+#define STREAM_DELTA    'D'
+
+namespace LEDSpicer::Utilities {
+
+/**
+ * LEDSpicer::Utilities::FrameStream
+ *
+ * Publishes the LEDs state to subscribers connected to a unix domain SOCK_SEQPACKET socket.
+ *
+ * A subscriber connects and optionally sends the frames per second it wants as text,
+ * it receives the metadata packet once and then the frames:
+ * - Metadata: 'M' followed by the metadata text.
+ * - Keyframe: 'K', the frame number (uint32) and the LEDs.
+ * - Delta:    'D', the frame number (uint32) and runs of
+ *   [unchanged bytes (uint16)][run length (uint16)][run length bytes XOR the previous frame].
+ * Numbers are little endian.
+ *
+ * Publishing never blocks, a subscriber that is not reading loses frames,
+ * the next frame it gets is a delta against the last one it received.
+ */
+class FrameStream {
+
+public:
+
+	/**
+	 * Creates the socket file and starts listening.
+	 *
+	 * @param path the socket file.
+	 * @param fps the frame rate of the publisher, the maximum a subscriber can request.
+	 * @param allowedUsers users allowed to subscribe, empty for everyone.
+	 * @throws Error if fails to bind.
+	 */
+	FrameStream(const string& path, uint8_t fps, const vector<uid_t>& allowedUsers = {});
+
+	FrameStream(const FrameStream&) = delete;
+	FrameStream& operator=(const FrameStream&) = delete;
+
+	/**
+	 * Disconnects the subscribers and removes the socket file.
+	 */
+	virtual ~FrameStream();
+
+	/**
+	 * Sets the metadata sent to new subscribers.
+	 *
+	 * @param metadata
+	 */
+	void setMetadata(const string& metadata);
+
+	/**
+	 * Sends the frame to the subscribers that are due.
+	 *
+	 * @param frame the LEDs of all the devices.
+	 */
+	void publish(const vector<uint8_t>& frame) noexcept;
+
+	/**
+	 * @return the number of connected subscribers.
+	 */
+	size_t getSubscribers() const;
+
+	/**
+	 * @return the socket file.
+	 */
+	const string& getPath() const;
+
+	/**
+	 * Appends to output the changes from previous to current.
+	 *
+	 * @param previous
+	 * @param current
+	 * @param[out] output
+	 * @param limit stops encoding when the output exceeds this size.
+	 * @return false if the frames have different sizes or the limit was exceeded.
+	 */
+	static bool encodeDelta(
+		const vector<uint8_t>& previous,
+		const vector<uint8_t>& current,
+		string& output,
+		size_t limit = SIZE_MAX
+	);
+
+	/**
+	 * Applies the changes encoded by encodeDelta.
+	 *
+	 * @param[in,out] frame
+	 * @param delta
+	 * @param size
+	 * @return false if the delta does not fit the frame.
+	 */
+	static bool applyDelta(vector<uint8_t>& frame, const uint8_t* delta, size_t size);
+
+protected:
+
+	struct Subscriber {
+		/// The connection.
+		int fd;
+		/// Frames to skip between sends.
+		uint8_t divider;
+		/// Frames skipped since the last send.
+		uint8_t skipped;
+		/// Frames sent since the last keyframe.
+		uint16_t sinceKeyframe;
+		/// True until the metadata is delivered.
+		bool pendingMetadata;
+		/// Last frame delivered, empty if none.
+		vector<uint8_t> last;
+	};
+
+	/// Listening socket.
+	int socketFB = -1;
+
+	/// Socket file.
+	string path;
+
+	/// Publisher frame rate.
+	uint8_t fps;
+
+	/// Users allowed to subscribe.
+	vector<uid_t> allowedUsers;
+
+	/// Metadata text.
+	string metadata;
+
+	/// Connected subscribers.
+	vector<Subscriber> subscribers;
+
+	/// Frames published.
+	uint32_t frameNumber = 0;
+
+	/// Packet buffer, reused between frames.
+	string packet;
+
+	/**
+	 * Accepts the pending subscribers.
+	 */
+	void acceptSubscribers() noexcept;
+
+	/**
+	 * Reads the rate requested by a subscriber.
+	 *
+	 * @param subscriber
+	 * @return false if the subscriber is gone.
+	 */
+	bool readRequest(Subscriber& subscriber) noexcept;
+
+	/**
+	 * Sends a packet without blocking.
+	 *
+	 * @param subscriber
+	 * @param data
+	 * @return -1 if the subscriber is gone, 0 if the packet was dropped, 1 if it was sent.
+	 */
+	static int8_t sendPacket(const Subscriber& subscriber, const string& data) noexcept;
+
+	/**
+	 * Appends a little endian number.
+	 *
+	 * @param output
+	 * @param value
+	 * @param bytes
+	 */
+	static void appendNumber(string& output, uint32_t value, uint8_t bytes);
+};
+
+} // namespace
@@ -0,0 +1,114 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      KeyframeAnimation.cpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "KeyframeAnimation.hpp"
+
+using namespace LEDSpicer::Utilities;
+
+void KeyframeAnimation::add(const vector<uint8_t>& rgb) {
+
+	uint16_t count = rgb.size() / CHANNELS;
+	elements = std::max(elements, count);
+	Frame frame {static_cast<uint32_t>(data.size()), count, true};
+
+	if (not frames.empty() and sinceKeyframe < KEYFRAME_INTERVAL - 1 and last.size() == rgb.size()) {
+		size_t changes = 0;
+		for (uint16_t e = 0; e < count; ++e)
+			if (std::memcmp(&last[e * CHANNELS], &rgb[e * CHANNELS], CHANNELS))
+				++changes;
+		frame.keyframe = changes * CHANGE_SIZE >= rgb.size();
+		if (not frame.keyframe) {
+			for (uint16_t e = 0; e < count; ++e) {
+				if (not std::memcmp(&last[e * CHANNELS], &rgb[e * CHANNELS], CHANNELS))
+					continue;
+				data.push_back(e & 0xFF);
+				data.push_back(e >> 8);
+				data.insert(data.end(), &rgb[e * CHANNELS], &rgb[e * CHANNELS] + CHANNELS);
+			}
+		}
+	}
+
+	if (frame.keyframe) {
+		data.insert(data.end(), rgb.begin(), rgb.begin() + count * CHANNELS);
+		sinceKeyframe = 0;
+	}
+	else {
+		++sinceKeyframe;
+	}
+	frames.push_back(frame);
+	last.assign(rgb.begin(), rgb.begin() + count * CHANNELS);
+}
+
+void KeyframeAnimation::shrink() {
+	data.shrink_to_fit();
+	frames.shrink_to_fit();
+	last.clear();
+	last.shrink_to_fit();
+}
+
+uint32_t KeyframeAnimation::getFrames() const {
+	return frames.size();
+}
+
+uint16_t KeyframeAnimation::getElements() const {
+	return elements;
+}
+
+size_t KeyframeAnimation::getMemory() const {
+	return data.capacity() + frames.capacity() * sizeof(Frame);
+}
+
+uint16_t KeyframeAnimation::decode(uint32_t frame, uint8_t* rgb, uint32_t& decoded) const {
+
+	if (decoded == frame)
+		return frames[frame].elements;
+
+	uint32_t keyframe = frame;
+	while (not frames[keyframe].keyframe)
+		--keyframe;
+
+	// Continue from the frame decoded when it is on the way, forward playing applies one delta.
+	uint32_t start;
+	if (decoded != NO_FRAME and decoded >= keyframe and decoded < frame) {
+		start = decoded + 1;
+	}
+	else {
+		std::memcpy(rgb, &data[frames[keyframe].offset], frames[keyframe].elements * CHANNELS);
+		start = keyframe + 1;
+	}
+	for (uint32_t f = start; f <= frame; ++f)
+		apply(f, rgb);
+	decoded = frame;
+	return frames[frame].elements;
+}
+
+size_t KeyframeAnimation::getEnd(uint32_t frame) const {
+	return frame + 1 < frames.size() ? frames[frame + 1].offset : data.size();
+}
+
+void KeyframeAnimation::apply(uint32_t frame, uint8_t* rgb) const {
+	for (size_t c = frames[frame].offset, end = getEnd(frame); c < end; c += CHANGE_SIZE) {
+		uint16_t element = data[c] | data[c + 1] << 8;
+		std::memcpy(rgb + element * CHANNELS, &data[c + 2], CHANNELS);
+	}
+}
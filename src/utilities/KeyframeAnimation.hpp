@@ -0,0 +1,128 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      KeyframeAnimation.hpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "Defaults.hpp"
+
+#pragma once
+
+/// Most frames between keyframes, the longest a seek has to replay.
+#define KEYFRAME_INTERVAL 32
+
+namespace LEDSpicer::Utilities {
+
+/**
+ * LEDSpicer::Utilities::KeyframeAnimation
+ *
+ * Animation frames kept as RGB keyframes followed by the elements that changed on every frame.
+ * A frame is a keyframe every KEYFRAME_INTERVAL frames, when the number of elements changes
+ * or when listing the changes takes more room than the frame.
+ * Decoding from the previous frame applies one delta, any other frame is reached from its keyframe.
+ */
+class KeyframeAnimation {
+
+public:
+
+	/// RGB per element.
+	static constexpr uint8_t CHANNELS = 3;
+
+	/// Frame not decoded yet.
+	static constexpr uint32_t NO_FRAME = UINT32_MAX;
+
+	/**
+	 * Appends a frame.
+	 * @param rgb RGB for every element.
+	 */
+	void add(const vector<uint8_t>& rgb);
+
+	/**
+	 * Releases the room left from adding frames.
+	 */
+	void shrink();
+
+	/**
+	 * @return the number of frames.
+	 */
+	uint32_t getFrames() const;
+
+	/**
+	 * @return the elements of the biggest frame.
+	 */
+	uint16_t getElements() const;
+
+	/**
+	 * @return the bytes used by the frames.
+	 */
+	size_t getMemory() const;
+
+	/**
+	 * Decodes a frame.
+	 * @param frame
+	 * @param[in,out] rgb the frame decoded last, receives the new frame, needs room for getElements() elements.
+	 * @param[in,out] decoded the frame in rgb, NO_FRAME if none.
+	 * @return the number of elements on the frame.
+	 */
+	uint16_t decode(uint32_t frame, uint8_t* rgb, uint32_t& decoded) const;
+
+protected:
+
+	/// Bytes per change, the element (uint16) and the RGB.
+	static constexpr uint8_t CHANGE_SIZE = 2 + CHANNELS;
+
+	struct Frame {
+		/// Start of the frame on data.
+		uint32_t offset;
+		/// Elements on the frame.
+		uint16_t elements;
+		/// True for RGB, false for changes.
+		bool keyframe;
+	};
+
+	vector<Frame> frames;
+
+	/// Keyframes and changes.
+	vector<uint8_t> data;
+
+	/// Last frame added, to calculate the next changes.
+	vector<uint8_t> last;
+
+	/// Frames since the last keyframe.
+	uint8_t sinceKeyframe = 0;
+
+	/// Elements of the biggest frame.
+	uint16_t elements = 0;
+
+	/**
+	 * @param frame
+	 * @return the end of the frame on data.
+	 */
+	size_t getEnd(uint32_t frame) const;
+
+	/**
+	 * Applies the changes of a frame.
+	 * @param frame
+	 * @param rgb
+	 */
+	void apply(uint32_t frame, uint8_t* rgb) const;
+};
+
+} // namespace
@@ -34,6 +34,101 @@ const string Message::toString() const {
 	return ss.str();
 }
 
+const string Message::toBinary() const {
+	if (data.size() > BINARY_MAX_FIELDS)
+		throw Error("Too many fields for a binary message: ") << to_string(data.size());
+	auto addLength = [](string& ret, size_t length) {
+		if (length > BINARY_MAX_LENGTH)
+			throw Error("Field too long for a binary message: ") << to_string(length);
+		ret += static_cast<char>(length & 0xFF);
+		ret += static_cast<char>(length >> 8);
+	};
+	string ret;
+	ret.reserve(BINARY_HEADER + data.size() * (BINARY_FIELD + 8));
+	ret += static_cast<char>(BINARY_MAGIC);
+	ret += static_cast<char>(BINARY_VERSION);
+	ret += static_cast<char>(type);
+	ret += static_cast<char>(flags);
+	ret += static_cast<char>(data.size());
+	for (size_t field = 0; field < data.size(); ++field) {
+		if (field < operations.size()) {
+			string operation(operations[field].toBinary());
+			ret += static_cast<char>(Fields::Operation);
+			addLength(ret, operation.size());
+			ret += operation;
+			continue;
+		}
+		uint16_t id = getId(field);
+		if (id != NO_ID) {
+			ret += static_cast<char>(Fields::Id);
+			ret += static_cast<char>(sizeof(id));
+			ret += '\0';
+			ret += static_cast<char>(id & 0xFF);
+			ret += static_cast<char>(id >> 8);
+			continue;
+		}
+		ret += static_cast<char>(Fields::Text);
+		addLength(ret, data[field].size());
+		ret += data[field];
+	}
+	return ret;
+}
+
+bool Message::fromBinary(const string& buffer, Message& message) {
+	return parseBinary(buffer, message, false);
+}
+
+bool Message::parseBinary(std::string_view buffer, Message& message, bool nested) {
+
+	if (not isBinary(buffer) or buffer[1] != BINARY_VERSION)
+		return false;
+
+	auto byte = [&buffer](size_t pos) { return static_cast<uint8_t>(buffer[pos]); };
+
+	message.reset();
+	message.type  = static_cast<Types>(byte(2));
+	message.flags = byte(3);
+	if (message.type == Types::Invalid or message.type > Types::Batch)
+		return false;
+
+	uint8_t fields = byte(4);
+	size_t pos = BINARY_HEADER;
+	for (uint8_t field = 0; field < fields; ++field) {
+		if (pos + BINARY_FIELD > buffer.size())
+			return false;
+		Fields kind = static_cast<Fields>(byte(pos));
+		size_t len  = byte(pos + 1) | (byte(pos + 2) << 8);
+		pos += BINARY_FIELD;
+		if (pos + len > buffer.size())
+			return false;
+		switch (kind) {
+		case Fields::Text:
+			message.addData(string(buffer.substr(pos, len)));
+			break;
+		case Fields::Id:
+			if (len != sizeof(uint16_t))
+				return false;
+			message.addId(byte(pos) | (byte(pos + 1) << 8));
+			break;
+		case Fields::Operation: {
+			// Only one level, batch operations cannot be batches.
+			if (nested or message.type != Types::Batch or len < BINARY_HEADER or not isBatchable(static_cast<Types>(byte(pos + 2))))
+				return false;
+			Message operation;
+			if (not parseBinary(buffer.substr(pos, len), operation, true))
+				return false;
+			message.addOperation(operation);
+			break;
+		}
+		default:
+			return false;
+		}
+		pos += len;
+	}
+	// Optional terminator.
+	return pos == buffer.size() or (not nested and pos + 1 == buffer.size() and buffer[pos] == '\0');
+}
+
 const string Message::toHumanString() const {
 	string ret(Utility::implode(data, ID_GROUP_SEPARATOR));
 	std::replace(ret.begin(), ret.end(), FIELD_SEPARATOR, ID_SEPARATOR);
@@ -65,6 +160,8 @@ const string Message::type2str(const Types type) {
 		return "ClearAllGroups";
 	case Types::CraftProfile:
 		return "CraftProfile";
+	case Types::Batch:
+		return "Batch";
 	default:
 		throw Error("Unknown type");
 	}
@@ -93,6 +190,8 @@ Message::Types Message::str2type(const string& type) {
 		return Types::ClearAllGroups;
 	if (type == "CraftProfile")
 		return Types::CraftProfile;
+	if (type == "Batch")
+		return Types::Batch;
 	throw Error("Invalid type ") << type;
 }
 
@@ -131,10 +230,75 @@ const vector<string>& Message::getData() const {
 
 void Message::setData(const vector<string>& data) {
 	this->data = data;
+	ids.clear();
+	operations.clear();
 }
 
 void Message::addData(const string& data) {
 	this->data.push_back(data);
+	if (not ids.empty())
+		ids.push_back(NO_ID);
+}
+
+void Message::addId(uint16_t id) {
+	ids.resize(data.size(), NO_ID);
+	ids.push_back(id);
+	data.push_back("#" + to_string(id));
+}
+
+uint16_t Message::getId(size_t field) const {
+	return field < ids.size() ? ids[field] : NO_ID;
+}
+
+void Message::addOperation(const Message& operation) {
+	if (not isBatchable(operation.type))
+		throw Error(type2str(operation.type)) << " cannot be batched";
+	string field(to_string(static_cast<int>(operation.type)));
+	for (const auto& d : operation.data)
+		field.append(1, GROUP_SEPARATOR).append(d);
+	// Only keep the operations while every field is one.
+	if (operations.size() == data.size())
+		operations.push_back(operation);
+	addData(field);
+}
+
+vector<Message> Message::getOperations() const {
+	if (not operations.empty() and operations.size() == data.size())
+		return operations;
+	vector<Message> operations;
+	operations.reserve(data.size());
+	for (const auto& field : data) {
+		vector<string> parts(Utility::explode(field, GROUP_SEPARATOR));
+		Message operation;
+		if (parts.empty()) {
+			operations.push_back(std::move(operation));
+			continue;
+		}
+		try {
+			Types type = static_cast<Types>(std::stoi(parts[0]));
+			if (isBatchable(type))
+				operation.type = type;
+		}
+		catch (...) {}
+		parts.erase(parts.begin());
+		operation.data = std::move(parts);
+		operations.push_back(std::move(operation));
+	}
+	return operations;
+}
+
+bool Message::isBatchable(const Types type) {
+	switch (type) {
+	case Types::SetElement:
+	case Types::ClearElement:
+	case Types::ClearAllElements:
+	case Types::SetGroup:
+	case Types::ClearGroup:
+	case Types::ClearAllGroups:
+		return true;
+	default:
+		return false;
+	}
 }
 
 Message::Types Message::getType() const {
@@ -156,4 +320,6 @@ void Message::setFlags(const uint8_t flags) {
 void Message::reset() {
 	type = Types::Invalid;
 	data.clear();
+	ids.clear();
+	operations.clear();
 }
@@ -21,13 +21,41 @@
  */
 
 #include "Utility.hpp"
+#include <string_view>
 
 #pragma once
 
+/**
+ * Binary protocol (v2)
+ * @{
+ */
+/// First byte of a binary message, never valid on UTF-8 text.
+#define BINARY_MAGIC   0xFE
+/// Binary protocol version.
+#define BINARY_VERSION 2
+/// Magic, version, type, flags and number of fields.
+#define BINARY_HEADER  5
+/// Field kind, and field length.
+#define BINARY_FIELD   3
+/// Most fields on a message, the count is a byte.
+#define BINARY_MAX_FIELDS 255
+/// Longest field, the length is an uint16.
+#define BINARY_MAX_LENGTH 65535
+/// Id used when a field is text.
+#define NO_ID          0xFFFF
+/// @}
+
 namespace LEDSpicer::Utilities {
 
 struct Message {
 
+	/// Binary field kinds.
+	enum class Fields : uint8_t {
+		Text,
+		Id,
+		Operation
+	};
+
 	enum class Types : uint8_t {
 		Invalid,
 		LoadProfile,
@@ -40,7 +68,8 @@ struct Message {
 		SetGroup,
 		ClearGroup,
 		ClearAllGroups,
-		CraftProfile
+		CraftProfile,
+		Batch
 	};
 
 	Message() = default;
@@ -53,6 +82,33 @@ struct Message {
 	 */
 	const string toString() const;
 
+	/**
+	 * Creates a binary message (protocol v2) to be send over the wire.
+	 * Header: magic, version, type, flags, number of fields.
+	 * Fields: kind, length (uint16 little endian), data, ids are uint16 little endian.
+	 * Batch operations are nested binary messages, so their ids survive.
+	 * @return a string with the binary data.
+	 * @throws Error if there are more than BINARY_MAX_FIELDS fields or one is longer than BINARY_MAX_LENGTH.
+	 */
+	const string toBinary() const;
+
+	/**
+	 * Parses a binary message (protocol v2).
+	 * One NUL after the last field is accepted, Socks::send terminates every message with it.
+	 * @param buffer
+	 * @param message the message to populate.
+	 * @return true if the message is valid.
+	 */
+	static bool fromBinary(const string& buffer, Message& message);
+
+	/**
+	 * @param buffer
+	 * @return true if the buffer starts like a binary message.
+	 */
+	static bool isBinary(std::string_view buffer) {
+		return buffer.size() >= BINARY_HEADER and static_cast<uint8_t>(buffer[0]) == BINARY_MAGIC;
+	}
+
 	/**
 	 * Creates a string to be displayed.
 	 * @return a string with the data in human readable format.
@@ -93,6 +149,40 @@ struct Message {
 
 	void addData(const string& data);
 
+	/**
+	 * Adds an interned id (element, group, color or filter) as the next field.
+	 * Ids are only supported by the binary protocol.
+	 * @param id
+	 */
+	void addId(uint16_t id);
+
+	/**
+	 * @param field
+	 * @return the interned id for the field, NO_ID if the field is text.
+	 */
+	uint16_t getId(size_t field) const;
+
+	/**
+	 * Adds an operation (Set or Clear message) into a batch message.
+	 * Each operation is a field with the type and data separated by GROUP_SEPARATOR,
+	 * the binary protocol sends the operation itself with its ids.
+	 * @param operation
+	 * @throws Error if the operation cannot be batched.
+	 */
+	void addOperation(const Message& operation);
+
+	/**
+	 * Extracts the operations from a batch message.
+	 * @return the list of operations, invalid ones are returned as Invalid type.
+	 */
+	vector<Message> getOperations() const;
+
+	/**
+	 * @param type
+	 * @return true if the type can be part of a batch.
+	 */
+	static bool isBatchable(const Types type);
+
 	Types getType() const;
 
 	void setType(Types type);
@@ -110,6 +200,22 @@ protected:
 	uint8_t flags = 0;
 
 	vector<string> data;
+
+	/// Interned ids by field, empty if every field is text.
+	vector<uint16_t> ids;
+
+	/// Batch operations by field, empty when the batch came as text.
+	vector<Message> operations;
+
+	/**
+	 * Parses a binary message, or a batch operation when nested.
+	 * Operations are only accepted on a batch that is not nested, so the depth is never over 1.
+	 * @param buffer
+	 * @param message the message to populate.
+	 * @param nested true when parsing a batch operation.
+	 * @return true if the message is valid.
+	 */
+	static bool parseBinary(std::string_view buffer, Message& message, bool nested);
 };
 
 } // namespace
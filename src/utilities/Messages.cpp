@@ -27,38 +27,71 @@ using namespace LEDSpicer::Utilities;
 
 bool Messages::read() {
 
-	string buffer;
-	if (receive(buffer)) {
+	// Keep the queue bounded, the rest waits on the socket.
+	if (messages.size() < MESSAGES_QUEUE_LIMIT) {
+		size_t
+			limit = MESSAGES_QUEUE_LIMIT - messages.size(),
+			count = 0;
+		if (Recorder::isReplaying()) {
+			for (; count < limit; ++count) {
+				if (buffers.size() == count)
+					buffers.emplace_back();
+				if (not Recorder::next(Recorder::Sources::Message, buffers[count]))
+					break;
+			}
+		}
+		else {
+			count = receiveBatch(buffers, limit);
+		}
+		for (size_t c = 0; c < count; ++c) {
+			if (buffers[c].empty()) continue;
+			Recorder::record(Recorder::Sources::Message, buffers[c]);
+			Message msg;
+			if (parse(buffers[c], msg))
+				messages.push(std::move(msg));
+		}
+	}
+	return messages.size() > 0;
+}
 
-		if (buffer.empty()) return false;
+bool Messages::hasMessages() const {
+	return messages.size() > 0;
+}
 
-		Message msg;
-		vector<string> chunks(Utility::explode(buffer, RECORD_SEPARATOR));
+bool Messages::parse(const string& buffer, Message& msg) {
 
-		if (chunks.size() == 1) {
-			LogNotice("Malformed message received");
+	// Binary protocol.
+	if (Message::isBinary(buffer)) {
+		if (not Message::fromBinary(buffer, msg)) {
+			LogNotice("Malformed binary message received");
 			return false;
 		}
+		return true;
+	}
+	vector<string> chunks(Utility::explode(buffer, RECORD_SEPARATOR));
 
-		try {
-			// Discard tale if empty.
-			if (chunks.back().empty()) chunks.pop_back();
-			msg.setType(static_cast<Message::Types>(std::stoi(chunks.back())));
-			if (msg.getType() == Message::Types::Invalid)
-				throw 1;
-			chunks.pop_back();
+	if (chunks.size() == 1) {
+		LogNotice("Malformed message received");
+		return false;
+	}
 
-			msg.setFlags(std::stoi(chunks.back()));
-		}
-		catch (...) {
-			LogNotice("Invalid message type received");
-			return false;
-		}
+	try {
+		// Discard tale if empty.
+		if (chunks.back().empty()) chunks.pop_back();
+		msg.setType(static_cast<Message::Types>(std::stoi(chunks.back())));
+		if (msg.getType() == Message::Types::Invalid)
+			throw 1;
 		chunks.pop_back();
-		msg.setData(std::move(chunks));
-		messages.push(msg);
+
+		msg.setFlags(std::stoi(chunks.back()));
 	}
-	return messages.size() > 0;
+	catch (...) {
+		LogNotice("Invalid message type received");
+		return false;
+	}
+	chunks.pop_back();
+	msg.setData(std::move(chunks));
+	return true;
 }
 
 Message Messages::getMessage() {
@@ -25,10 +25,14 @@ using std::queue;
 
 #include "utilities/Socks.hpp"
 #include "utilities/Utility.hpp"
+#include "utilities/Recorder.hpp"
 #include "Message.hpp"
 
 #pragma once
 
+/// Maximum number of messages waiting to be processed.
+#define MESSAGES_QUEUE_LIMIT 256
+
 namespace LEDSpicer::Utilities {
 
 /**
@@ -38,7 +42,23 @@ class Messages : protected Socks {
 
 public:
 
-	Messages(const string& port) : Socks(LOCALHOST, port, true) {}
+	/**
+	 * Listens for messages on a UDP port or on a unix domain socket.
+	 * @param port the UDP port, ignored when a socket file is provided.
+	 * @param path the unix socket file, empty to use the port.
+	 * @param sockType SOCK_DGRAM or SOCK_SEQPACKET.
+	 * @param allowedUsers user ids allowed to send over the unix socket, empty for everyone.
+	 */
+	Messages(
+		const string& port,
+		const string& path = "",
+		int sockType = SOCK_DGRAM,
+		const vector<uid_t>& allowedUsers = {}
+	) : Socks(LOCALHOST, path.empty() ? port : "", true) {
+		if (path.empty()) return;
+		setAllowedUsers(allowedUsers);
+		prepareUnix(path, true, sockType);
+	}
 
 	virtual ~Messages() = default;
 
@@ -50,16 +70,35 @@ public:
 	Message getMessage();
 
 	/**
-	 * Reads a messages from the socket.
+	 * Drains the pending messages from the socket into the queue.
 	 *
-	 * @return true if a message was received, false otherwise.
+	 * @return true if there are messages waiting, false otherwise.
 	 */
 	bool read();
 
+	/**
+	 * @return true if there are messages waiting.
+	 */
+	bool hasMessages() const;
+
+	using Socks::wait;
+
 protected:
 
 	queue<Message> messages;
 
+	/// Raw messages from the last read, reused between reads.
+	vector<string> buffers;
+
+	/**
+	 * Decodes a text or binary message.
+	 *
+	 * @param buffer
+	 * @param[out] msg
+	 * @return true if the message is valid.
+	 */
+	static bool parse(const string& buffer, Message& msg);
+
 };
 
 } // namespace
@@ -0,0 +1,141 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      RandomGenerator.hpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "Defaults.hpp"
+
+#pragma once
+
+namespace LEDSpicer::Utilities {
+
+/**
+ * LEDSpicer::Utilities::RandomGenerator
+ *
+ * Small xoshiro128** pseudo random generator, every user keeps its own so the
+ * numbers do not depend on what else is running and nothing is locked.
+ * The same seed always produces the same numbers.
+ *
+ * The global seed is set once on start (or by a recording) and is where
+ * the generators without an explicit seed come from.
+ */
+class RandomGenerator {
+
+public:
+
+	/**
+	 * @param seed
+	 */
+	explicit RandomGenerator(uint64_t seed = 0) {
+		this->seed(seed);
+	}
+
+	/**
+	 * Restarts the sequence.
+	 * @param seed
+	 */
+	void seed(uint64_t seed) noexcept {
+		// splitmix64 spreads the seed, the state cannot be all zeros.
+		for (uint8_t c = 0; c < 4; c += 2) {
+			uint64_t z = (seed += 0x9E3779B97F4A7C15);
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+			z ^= z >> 31;
+			state[c]     = z;
+			state[c + 1] = z >> 32;
+		}
+	}
+
+	/**
+	 * @return the next number.
+	 */
+	uint32_t next() noexcept {
+		uint32_t
+			result = rotate(state[1] * 5, 7) * 9,
+			t      = state[1] << 9;
+		state[2] ^= state[0];
+		state[3] ^= state[1];
+		state[1] ^= state[2];
+		state[0] ^= state[3];
+		state[2] ^= t;
+		state[3]  = rotate(state[3], 11);
+		return result;
+	}
+
+	/**
+	 * @param limit
+	 * @return a number from 0 to limit - 1, zero if limit is zero.
+	 */
+	uint32_t below(uint32_t limit) noexcept {
+		return (static_cast<uint64_t>(next()) * limit) >> 32;
+	}
+
+	/**
+	 * Sets the global seed and restarts the shared generator.
+	 * @param seed
+	 */
+	static void setSeed(uint32_t seed) noexcept {
+		globalSeed = seed;
+		shared().seed(seed);
+	}
+
+	/**
+	 * @return the global seed.
+	 */
+	static uint32_t getSeed() noexcept {
+		return globalSeed;
+	}
+
+	/**
+	 * @param stream a number that tells the users apart, like the actor number.
+	 * @return a seed for a user from the global seed.
+	 */
+	static uint64_t getSeed(uint32_t stream) noexcept {
+		return static_cast<uint64_t>(stream) << 32 | globalSeed;
+	}
+
+	/**
+	 * @return the generator for the users that have none, seeded with the global seed.
+	 */
+	static RandomGenerator& shared() noexcept {
+		static RandomGenerator generator(globalSeed);
+		return generator;
+	}
+
+protected:
+
+	/// Generator state.
+	uint32_t state[4];
+
+	/// Global seed.
+	inline static uint32_t globalSeed = 0;
+
+	/**
+	 * @param value
+	 * @param bits
+	 * @return value rotated to the left.
+	 */
+	static uint32_t rotate(uint32_t value, uint8_t bits) noexcept {
+		return (value << bits) | (value >> (32 - bits));
+	}
+};
+
+} // namespace
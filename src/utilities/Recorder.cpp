@@ -0,0 +1,209 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      Recorder.cpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "Recorder.hpp"
+#include "RandomGenerator.hpp"
+
+using namespace LEDSpicer::Utilities;
+using std::chrono::steady_clock;
+using std::chrono::microseconds;
+
+/// Record header size, source, data size and time.
+#define RECORD_HEADER_SIZE (1 + 4 + 8)
+
+void Recorder::startRecording(const string& path) {
+	outputFile.open(path, std::ios::binary | std::ios::trunc);
+	if (not outputFile)
+		throw Error("Unable to create recording ") << path;
+	filePath = path;
+	// Replays start from the same numbers.
+	uint32_t seed = RandomGenerator::getSeed();
+	RandomGenerator::setSeed(seed);
+	uint8_t version = RECORDER_VERSION;
+	outputFile.write(RECORDER_MAGIC, sizeof(RECORDER_MAGIC) - 1);
+	outputFile.write(reinterpret_cast<const char*>(&version), sizeof(version));
+	outputFile.write(reinterpret_cast<const char*>(&seed), sizeof(seed));
+	start     = steady_clock::now();
+	frames    = 0;
+	recording = true;
+	writeFrame();
+	LogInfo("Recording into " + path);
+}
+
+void Recorder::startReplay(const string& path) {
+	std::ifstream file(path, std::ios::binary);
+	if (not file)
+		throw Error("Unable to open recording ") << path;
+	char magic[sizeof(RECORDER_MAGIC) - 1];
+	uint8_t version = 0;
+	uint32_t seed   = 0;
+	file.read(magic, sizeof(magic));
+	file.read(reinterpret_cast<char*>(&version), sizeof(version));
+	file.read(reinterpret_cast<char*>(&seed), sizeof(seed));
+	if (not file or string(magic, sizeof(magic)) != RECORDER_MAGIC)
+		throw Error("Invalid recording ") << path;
+	if (version != RECORDER_VERSION)
+		throw Error("Unsupported recording version ") << to_string(version);
+
+	// The first record is the first frame.
+	uint8_t source = 0;
+	uint32_t size  = 0;
+	int64_t time   = 0, frameTime = 0;
+	file.read(reinterpret_cast<char*>(&source), sizeof(source));
+	file.read(reinterpret_cast<char*>(&size), sizeof(size));
+	file.read(reinterpret_cast<char*>(&time), sizeof(time));
+	file.read(reinterpret_cast<char*>(&frameTime), sizeof(frameTime));
+	if (not file or source != static_cast<uint8_t>(Sources::Frame) or size != sizeof(frameTime))
+		throw Error("Invalid recording ") << path;
+
+	RandomGenerator::setSeed(seed);
+	inputFile     = std::move(file);
+	filePath      = path;
+	nextFrameTime = system_clock::time_point(microseconds(frameTime));
+	pendingFrame  = true;
+	frames        = mismatches = 0;
+	renderTotal   = renderMax  = 0;
+	replaying     = true;
+	LogInfo("Replaying " + path);
+	readFrame();
+	start = frameStart = steady_clock::now();
+}
+
+void Recorder::stop() {
+	if (recording) {
+		recording = false;
+		outputFile.close();
+		LogInfo("Recorded " + to_string(frames) + " frames into " + filePath);
+	}
+	if (replaying) {
+		replaying = false;
+		inputFile.close();
+		for (auto& r : records)
+			r.clear();
+		Time::setVirtualTime({});
+		LogInfo(
+			"Replayed " + to_string(frames) + " frames from " + filePath + ", " + to_string(mismatches) + " differ from the recording, "
+			"frame time average " + to_string(frames ? renderTotal / frames : 0) + "us slowest " + to_string(renderMax) + "us"
+		);
+	}
+}
+
+bool Recorder::next(Sources source, string& data) {
+	auto& pending = records[static_cast<size_t>(source)];
+	if (not replaying or pending.empty())
+		return false;
+	data = std::move(pending.front());
+	pending.pop_front();
+	return true;
+}
+
+bool Recorder::newFrame() {
+	if (recording) {
+		writeFrame();
+		return true;
+	}
+	if (not replaying)
+		return true;
+
+	// The replay does not wait, the time between frames is the time to render.
+	auto now = steady_clock::now();
+	int64_t render = std::chrono::duration_cast<microseconds>(now - frameStart).count();
+	frameStart   = now;
+	renderTotal += render;
+	renderMax    = std::max(renderMax, render);
+
+	return readFrame();
+}
+
+void Recorder::output(uint64_t hash) {
+	if (recording) {
+		write(Sources::Output, &hash, sizeof(hash));
+		return;
+	}
+	string recorded;
+	if (not next(Sources::Output, recorded))
+		return;
+	if (recorded.size() == sizeof(hash) and std::memcmp(recorded.data(), &hash, sizeof(hash)) == 0)
+		return;
+	if (not mismatches++)
+		LogNotice("Frame " + to_string(frames) + " differs from the recording");
+}
+
+uint32_t Recorder::getFrames() {
+	return frames;
+}
+
+uint32_t Recorder::getMismatches() {
+	return mismatches;
+}
+
+void Recorder::write(Sources source, const void* data, size_t size) {
+	uint8_t code   = static_cast<uint8_t>(source);
+	uint32_t total = size;
+	int64_t time   = std::chrono::duration_cast<microseconds>(steady_clock::now() - start).count();
+	outputFile.write(reinterpret_cast<const char*>(&code), sizeof(code));
+	outputFile.write(reinterpret_cast<const char*>(&total), sizeof(total));
+	outputFile.write(reinterpret_cast<const char*>(&time), sizeof(time));
+	if (size)
+		outputFile.write(static_cast<const char*>(data), size);
+}
+
+void Recorder::writeFrame() {
+	int64_t time = std::chrono::duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+	write(Sources::Frame, &time, sizeof(time));
+	++frames;
+}
+
+bool Recorder::readFrame() {
+
+	if (not pendingFrame)
+		return false;
+
+	// Whatever the last frame did not use is dropped, so a difference does not move the next frames.
+	for (auto& r : records)
+		r.clear();
+	Time::setVirtualTime(nextFrameTime);
+	pendingFrame = false;
+	++frames;
+
+	char header[RECORD_HEADER_SIZE];
+	while (inputFile.read(header, sizeof(header))) {
+		uint8_t source = header[0];
+		uint32_t size;
+		std::memcpy(&size, header + 1, sizeof(size));
+		string data(size, 0);
+		if (size and not inputFile.read(data.data(), size))
+			break;
+		if (source == static_cast<uint8_t>(Sources::Frame)) {
+			int64_t time = 0;
+			if (size == sizeof(time))
+				std::memcpy(&time, data.data(), sizeof(time));
+			nextFrameTime = system_clock::time_point(microseconds(time));
+			pendingFrame  = true;
+			break;
+		}
+		if (source < static_cast<uint8_t>(Sources::Count))
+			records[source].push_back(std::move(data));
+	}
+	return true;
+}
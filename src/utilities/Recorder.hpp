@@ -0,0 +1,211 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      Recorder.hpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <fstream>
+#include <deque>
+
+#include "Time.hpp"
+#include "Error.hpp"
+#include "Log.hpp"
+
+#pragma once
+
+/// Recording file signature.
+#define RECORDER_MAGIC   "LEDSpicerRec"
+/// Recording format version.
+#define RECORDER_VERSION 1
+
+namespace LEDSpicer::Utilities {
+
+/**
+ * LEDSpicer::Utilities::Recorder
+ *
+ * Records everything the daemon consumes on every frame, and replays it
+ * through the same code paths with a virtual clock.
+ *
+ * The file starts with the signature, the version (uint8) and the random seed (uint32),
+ * then records of [source (uint8)][size (uint32)][monotonic microseconds since the start (int64)][data].
+ * Every frame starts with a Frame record holding the frame time as system clock microseconds,
+ * the records that follow belong to that frame. Numbers are native endian.
+ */
+class Recorder {
+
+public:
+
+	enum class Sources : uint8_t {
+		/// Frame start.
+		Frame,
+		/// Raw control message.
+		Message,
+		/// Reader key event.
+		Input,
+		/// Data read from MAME.
+		Mame,
+		/// Audio peaks.
+		Audio,
+		/// Hash of the LEDs sent to the devices.
+		Output,
+		Count
+	};
+
+	virtual ~Recorder() = default;
+
+	/**
+	 * Starts recording into a file and reseeds the random numbers with the global seed, which is recorded.
+	 * @param path
+	 * @throws Error if the file cannot be created.
+	 */
+	static void startRecording(const string& path);
+
+	/**
+	 * Loads a recording, reseeds the random numbers and moves the clock to the first frame.
+	 * @param path
+	 * @throws Error if the file is not a recording.
+	 */
+	static void startReplay(const string& path);
+
+	/**
+	 * Closes the file and logs the results.
+	 */
+	static void stop();
+
+	/**
+	 * @return true while recording.
+	 */
+	static bool isRecording() {
+		return recording;
+	}
+
+	/**
+	 * @return true while replaying.
+	 */
+	static bool isReplaying() {
+		return replaying;
+	}
+
+	/**
+	 * Stores a record on the current frame, does nothing if not recording.
+	 * @param source
+	 * @param data
+	 * @param size
+	 */
+	static void record(Sources source, const void* data, size_t size) {
+		if (recording)
+			write(source, data, size);
+	}
+
+	/**
+	 * @param source
+	 * @param data
+	 */
+	static void record(Sources source, const string& data) {
+		record(source, data.data(), data.size());
+	}
+
+	/**
+	 * Retrieves the next record of a source on the current frame.
+	 * @param source
+	 * @param[out] data
+	 * @return false if the source has nothing else on this frame.
+	 */
+	static bool next(Sources source, string& data);
+
+	/**
+	 * Starts a new frame, when replaying moves the clock to the recorded frame time.
+	 * @return false when the replay is over.
+	 */
+	static bool newFrame();
+
+	/**
+	 * Records the LEDs hash, when replaying compares it with the recorded one.
+	 * @param hash
+	 */
+	static void output(uint64_t hash);
+
+	/**
+	 * @return the number of frames recorded or replayed.
+	 */
+	static uint32_t getFrames();
+
+	/**
+	 * @return the number of replayed frames that differ from the recording.
+	 */
+	static uint32_t getMismatches();
+
+protected:
+
+	inline static bool
+		recording = false,
+		replaying = false,
+		/// True if the replay has another frame.
+		pendingFrame = false;
+
+	/// Recording file.
+	inline static string filePath;
+
+	inline static std::ofstream outputFile;
+
+	inline static std::ifstream inputFile;
+
+	/// When the recording or replay started.
+	inline static std::chrono::steady_clock::time_point start;
+
+	/// When the last frame started, measures the replayed frames.
+	inline static std::chrono::steady_clock::time_point frameStart;
+
+	/// Next replayed frame time.
+	inline static system_clock::time_point nextFrameTime;
+
+	/// Records of the current replayed frame by source.
+	inline static array<std::deque<string>, static_cast<size_t>(Sources::Count)> records;
+
+	inline static uint32_t
+		frames     = 0,
+		mismatches = 0;
+
+	/// Replay frames render time, microseconds.
+	inline static int64_t
+		renderTotal = 0,
+		renderMax   = 0;
+
+	/**
+	 * Writes a record.
+	 * @param source
+	 * @param data
+	 * @param size
+	 */
+	static void write(Sources source, const void* data, size_t size);
+
+	/**
+	 * Writes a frame record with the current time.
+	 */
+	static void writeFrame();
+
+	/**
+	 * Reads the records of the next frame.
+	 * @return false if there are no more frames.
+	 */
+	static bool readFrame();
+};
+
+} // namespace
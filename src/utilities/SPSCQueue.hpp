@@ -0,0 +1,149 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      SPSCQueue.hpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Defaults.hpp"
+#include <atomic>
+
+#pragma once
+
+namespace LEDSpicer::Utilities {
+
+/**
+ * LEDSpicer::Utilities::SPSCQueue
+ *
+ * Lock free ring for one producer thread and one consumer thread.
+ * Nothing is allocated after construction, when full the producer gets false.
+ *
+ * @tparam T the item type.
+ * @tparam N the capacity, a power of two.
+ */
+template <typename T, size_t N>
+class SPSCQueue {
+
+	static_assert(N and not (N & (N - 1)), "SPSCQueue capacity must be a power of two");
+
+public:
+
+	SPSCQueue() = default;
+
+	SPSCQueue(const SPSCQueue&) = delete;
+	SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+	/**
+	 * Producer side, stores an item.
+	 * @param item
+	 * @return false if the queue is full.
+	 */
+	bool push(const T& item) noexcept {
+		size_t h = head.load(std::memory_order_relaxed);
+		if (h - tail.load(std::memory_order_acquire) == N)
+			return false;
+		buffer[h & (N - 1)] = item;
+		head.store(h + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * Consumer side, retrieves the oldest item.
+	 * @param[out] item
+	 * @return false if the queue is empty.
+	 */
+	bool pop(T& item) noexcept {
+		size_t t = tail.load(std::memory_order_relaxed);
+		if (t == head.load(std::memory_order_acquire))
+			return false;
+		item = buffer[t & (N - 1)];
+		tail.store(t + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * Producer side, stores as many items as fit.
+	 * @param items
+	 * @param count
+	 * @return the number of items stored.
+	 */
+	size_t push(const T* items, size_t count) noexcept {
+		size_t h = head.load(std::memory_order_relaxed);
+		count = std::min(count, N - (h - tail.load(std::memory_order_acquire)));
+		for (size_t c = 0; c < count; ++c)
+			buffer[(h + c) & (N - 1)] = items[c];
+		head.store(h + count, std::memory_order_release);
+		return count;
+	}
+
+	/**
+	 * Consumer side, retrieves up to count of the oldest items.
+	 * @param[out] items
+	 * @param count
+	 * @return the number of items retrieved.
+	 */
+	size_t pop(T* items, size_t count) noexcept {
+		size_t t = tail.load(std::memory_order_relaxed);
+		count = std::min(count, head.load(std::memory_order_acquire) - t);
+		for (size_t c = 0; c < count; ++c)
+			items[c] = buffer[(t + c) & (N - 1)];
+		tail.store(t + count, std::memory_order_release);
+		return count;
+	}
+
+	/**
+	 * @return the number of items waiting, approximated while the other side runs.
+	 */
+	size_t size() const noexcept {
+		return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * @return true if nothing is waiting.
+	 */
+	bool empty() const noexcept {
+		return size() == 0;
+	}
+
+	/**
+	 * Consumer side, drops everything waiting.
+	 */
+	void clear() noexcept {
+		tail.store(head.load(std::memory_order_acquire), std::memory_order_release);
+	}
+
+	/**
+	 * @return the capacity.
+	 */
+	static constexpr size_t capacity() noexcept {
+		return N;
+	}
+
+protected:
+
+	/// Items.
+	array<T, N> buffer {};
+
+	/// Next slot to write, only changed by the producer.
+	alignas(64) std::atomic<size_t> head {0};
+
+	/// Next slot to read, only changed by the consumer.
+	alignas(64) std::atomic<size_t> tail {0};
+};
+
+} // namespace
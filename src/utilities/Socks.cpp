@@ -33,6 +33,8 @@ void Socks::prepare(const string& hostAddress, const string& hostPort, bool bind
 
 	if (socketFB) throw Error("Already prepared");
 
+	this->sockType = sockType;
+
 	if (bind) {
 		// Server Mode.
 		LogInfo("Listening on " + hostAddress + " port " + hostPort);
@@ -87,20 +89,101 @@ void Socks::prepare(const string& hostAddress, const string& hostPort, bool bind
 	}
 }
 
+void Socks::prepareUnix(const string& path, bool bind, int sockType) {
+
+	if (socketFB) throw Error("Already prepared");
+
+	sockaddr_un address {};
+	if (path.empty() or path.size() >= sizeof(address.sun_path))
+		throw Error("Invalid socket path ") << path;
+	address.sun_family = AF_UNIX;
+	path.copy(address.sun_path, path.size());
+
+	LogInfo((bind ? "Listening on " : "Connecting to ") + path);
+
+	socketFB = socket(AF_UNIX, sockType | SOCK_CLOEXEC, 0);
+	if (socketFB == -1) {
+		socketFB = 0;
+		throw Error("Failed to create socket ") << strerror(errno);
+	}
+	this->sockType = sockType;
+
+	// Client Mode.
+	if (not bind) {
+		if (::connect(socketFB, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1) {
+			string error(strerror(errno));
+			disconnect();
+			throw Error("Failed to connect to ") << path << " " << error;
+		}
+		return;
+	}
+
+	// Server Mode, remove the file left by a previous run.
+	::unlink(path.c_str());
+	if (
+		::bind(socketFB, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1 or
+		(sockType == SOCK_SEQPACKET and ::listen(socketFB, SOMAXCONN) == -1)
+	) {
+		string error(strerror(errno));
+		disconnect();
+		throw Error("Failed to bind to ") << path << " " << error;
+	}
+	unixPath = path;
+	if (sockType == SOCK_SEQPACKET)
+		fcntl(socketFB, F_SETFL, fcntl(socketFB, F_GETFL) | O_NONBLOCK);
+	if (not allowedUsers.empty())
+		setAllowedUsers(allowedUsers);
+}
+
+void Socks::setAllowedUsers(const vector<uid_t>& users) {
+	allowedUsers = users;
+	if (unixPath.empty() or allowedUsers.empty())
+		return;
+	// Credentials do the access control, so everyone can reach the socket.
+	chmod(unixPath.c_str(), 0666);
+	int on = 1;
+	if (sockType == SOCK_DGRAM and setsockopt(socketFB, SOL_SOCKET, SO_PASSCRED, &on, sizeof(on)) == -1)
+		LogWarning("Unable to request peer credentials " + string(strerror(errno)));
+}
+
+int Socks::str2type(const string& type) {
+	if (type == "Datagram")
+		return SOCK_DGRAM;
+	if (type == "SeqPacket")
+		return SOCK_SEQPACKET;
+	throw Error("Invalid socket type ") << type;
+}
+
 bool Socks::send(const string& message) noexcept {
 
 	if (not socketFB) return false;
 	if (message.empty()) return true;
 
-	string data = message + '\0';
-	const char* ptr = data.c_str();
-	size_t
-		totalSent = 0,
-		totalSize = data.size();
-	while (totalSent < totalSize) {
-		ssize_t sent = ::send(socketFB, ptr + totalSent, totalSize - totalSent, 0);
+	// The message and its terminator go out together without copying.
+	char terminator = '\0';
+	iovec parts[] = {
+		{const_cast<char*>(message.data()), message.size()},
+		{&terminator, 1}
+	};
+	msghdr header {};
+	header.msg_iov    = parts;
+	header.msg_iovlen = 2;
+	size_t pending    = message.size() + 1;
+	while (pending) {
+		ssize_t sent = ::sendmsg(socketFB, &header, MSG_NOSIGNAL);
 		if (sent <= 0) return false;
-		totalSent += sent;
+		pending -= sent;
+		// Partial sends only happen on streams, skip what was sent.
+		while (sent and header.msg_iovlen) {
+			size_t chunk = std::min<size_t>(sent, header.msg_iov->iov_len);
+			header.msg_iov->iov_base = static_cast<char*>(header.msg_iov->iov_base) + chunk;
+			header.msg_iov->iov_len -= chunk;
+			sent -= chunk;
+			if (not header.msg_iov->iov_len) {
+				++header.msg_iov;
+				--header.msg_iovlen;
+			}
+		}
 	}
 #ifdef DEVELOP
 	LogDebug("Message sent: [" + message + "]");
@@ -113,43 +196,202 @@ bool Socks::receive(string& buffer) noexcept {
 
 	buffer.clear();
 
-	fd_set readset;
-	FD_ZERO(&readset);
-	FD_SET(socketFB, &readset);
-	int ready = select(socketFB + 1, &readset, nullptr, nullptr, &tv);
-	// Check for available data
-	if (ready <= 0) return false;
+	// Unix connections, every client can send.
+	if (sockType == SOCK_SEQPACKET and not unixPath.empty()) {
+		acceptClients();
+		// Round robin, a busy client cannot starve the others.
+		for (size_t checked = 0, total = clients.size(); checked < total; ++checked) {
+			if (nextClient >= clients.size())
+				nextClient = 0;
+			int8_t result = readFrom(clients[nextClient], buffer);
+			if (result < 0) {
+				LogDebug("Client disconnected");
+				::close(clients[nextClient]);
+				clients.erase(clients.begin() + nextClient);
+				continue;
+			}
+			++nextClient;
+			if (result > 0)
+				return true;
+		}
+		return false;
+	}
+
+	return readFrom(socketFB, buffer) > 0;
+}
+
+ssize_t Socks::receive(char* buffer, size_t size) noexcept {
+	if (not socketFB) return -1;
+	ssize_t r = recv(socketFB, buffer, size, MSG_DONTWAIT);
+	if (r > 0)
+		return r;
+	// Zero on a stream is the peer closing the connection, on datagrams is an empty one.
+	if ((r == 0 and sockType == SOCK_DGRAM) or (r < 0 and (errno == EAGAIN or errno == EWOULDBLOCK or errno == EINTR)))
+		return 0;
+	return -1;
+}
+
+size_t Socks::receiveBatch(vector<string>& buffers, size_t max) noexcept {
 
-	// Check pending data size (UDP specific).
-	size_t pending = 0;
-	if (ioctl(socketFB, FIONREAD, &pending) < 0) return false;
-	if (pending == 0) return false;
+	if (not socketFB or not max) return 0;
 
-	// Dynamically allocate buffer based on pending size.
-	string temp;
-	temp.resize(pending);
-	ssize_t n = recv(socketFB, &temp[0], pending, 0);
+	size_t count = 0;
 
-	if (n <= 0) return false;
+	// Connections and credential checks are read one message at a time.
+	if (sockType != SOCK_DGRAM or (not unixPath.empty() and not allowedUsers.empty())) {
+		if (buffers.size() < max) buffers.resize(max);
+		while (count < max and receive(buffers[count]))
+			++count;
+		return count;
+	}
 
-	// Assume null-terminated; trim null if present.
-	if (n > 0 && temp[n - 1] == '\0') --n;
-	temp.resize(n);
-	buffer = std::move(temp);
+	if (not batchBuffer) {
+		// Pages are only touched by the datagrams that arrive.
+		batchBuffer.reset(new (std::nothrow) char[RECEIVE_BATCH * DATAGRAM_SIZE]);
+		if (not batchBuffer) return 0;
+		batchHeaders.resize(RECEIVE_BATCH);
+		batchParts.resize(RECEIVE_BATCH);
+		for (size_t slot = 0; slot < RECEIVE_BATCH; ++slot)
+			batchParts[slot] = {batchBuffer.get() + slot * DATAGRAM_SIZE, DATAGRAM_SIZE};
+	}
 
+	while (count < max) {
+		size_t slots = std::min(max - count, RECEIVE_BATCH);
+		for (size_t slot = 0; slot < slots; ++slot) {
+			batchHeaders[slot] = {};
+			batchHeaders[slot].msg_hdr.msg_iov    = &batchParts[slot];
+			batchHeaders[slot].msg_hdr.msg_iovlen = 1;
+		}
+		int received = recvmmsg(socketFB, batchHeaders.data(), slots, MSG_DONTWAIT, nullptr);
+		if (received <= 0) break;
+		if (buffers.size() < count + received) buffers.resize(count + received);
+		for (int slot = 0; slot < received; ++slot) {
+			if (batchHeaders[slot].msg_hdr.msg_flags & MSG_TRUNC) {
+				LogNotice("Oversized message discarded");
+				continue;
+			}
+			const char* data = static_cast<const char*>(batchParts[slot].iov_base);
+			size_t length    = batchHeaders[slot].msg_len;
+			buffers[count].assign(data, length);
+			trimTerminator(buffers[count++]);
 #ifdef DEVELOP
-	LogDebug("Message received: [" + buffer + "]");
+			LogDebug("Message received: [" + buffers[count - 1] + "]");
 #endif
+		}
+		// Less than requested, the socket is drained.
+		if (static_cast<size_t>(received) < slots) break;
+	}
+	return count;
+}
 
-	return true;
+bool Socks::wait(int milliseconds) noexcept {
+	if (not socketFB) return false;
+	vector<pollfd> fds {{socketFB, POLLIN, 0}};
+	for (int client : clients)
+		fds.push_back({client, POLLIN, 0});
+	return poll(fds.data(), fds.size(), milliseconds) > 0;
+}
+
+void Socks::acceptClients() {
+	while (true) {
+		int client = accept4(socketFB, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if (client < 0)
+			return;
+		ucred credentials {};
+		socklen_t size = sizeof(credentials);
+		if (getsockopt(client, SOL_SOCKET, SO_PEERCRED, &credentials, &size) == -1 or not isAllowed(credentials.uid)) {
+			LogNotice("Connection from user " + to_string(credentials.uid) + " rejected");
+			::close(client);
+			continue;
+		}
+		if (clients.size() >= SOCKET_CLIENTS) {
+			LogNotice("Connection from process " + to_string(credentials.pid) + " rejected, too many clients");
+			::close(client);
+			continue;
+		}
+		LogDebug("Client connected from process " + to_string(credentials.pid));
+		clients.push_back(client);
+	}
+}
+
+int8_t Socks::readFrom(int fd, string& buffer) noexcept {
+
+	// Messages from users not allowed are skipped.
+	while (true) {
+
+		// Check for available data
+		pollfd ready {fd, POLLIN, 0};
+		if (poll(&ready, 1, 0) <= 0) return 0;
+
+		// Check pending data size (UDP specific), readable and empty means the client is gone.
+		size_t pending = 0;
+		if (ioctl(fd, FIONREAD, &pending) < 0) return 0;
+		if (pending == 0) return fd == socketFB ? 0 : -1;
+
+		// Dynamically allocate buffer based on pending size.
+		string temp;
+		temp.resize(pending);
+		iovec part {&temp[0], pending};
+		char control[CMSG_SPACE(sizeof(ucred))];
+		msghdr header {};
+		header.msg_iov    = &part;
+		header.msg_iovlen = 1;
+		// Datagrams from unix clients carry their credentials.
+		bool checkCredentials = fd == socketFB and not unixPath.empty() and not allowedUsers.empty();
+		if (checkCredentials) {
+			header.msg_control    = control;
+			header.msg_controllen = sizeof(control);
+		}
+		ssize_t n = recvmsg(fd, &header, 0);
+
+		if (n <= 0) return fd == socketFB ? 0 : -1;
+
+		if (checkCredentials) {
+			cmsghdr* message = CMSG_FIRSTHDR(&header);
+			if (
+				not message or
+				message->cmsg_type != SCM_CREDENTIALS or
+				not isAllowed(reinterpret_cast<ucred*>(CMSG_DATA(message))->uid)
+			) {
+				LogNotice("Message from a not allowed user discarded");
+				continue;
+			}
+		}
+
+		temp.resize(n);
+		trimTerminator(temp);
+		buffer = std::move(temp);
+
+#ifdef DEVELOP
+		LogDebug("Message received: [" + buffer + "]");
+#endif
+
+		return 1;
+	}
+}
+
+void Socks::trimTerminator(string& buffer) noexcept {
+	if (not buffer.empty() and buffer.back() == '\0' and not Message::isBinary(buffer))
+		buffer.pop_back();
+}
+
+bool Socks::isAllowed(uid_t uid) const {
+	return allowedUsers.empty() or std::find(allowedUsers.begin(), allowedUsers.end(), uid) != allowedUsers.end();
 }
 
 void Socks::disconnect() {
+	for (int client : clients)
+		::close(client);
+	clients.clear();
 	if (socketFB) {
 		LogInfo("Closing network connection");
 		::close(socketFB);
 		socketFB = 0;
 	}
+	if (not unixPath.empty()) {
+		::unlink(unixPath.c_str());
+		unixPath.clear();
+	}
 }
 
 Socks::~Socks() {
@@ -24,11 +24,16 @@
 
 // For socket(), connect(), send(), and recv()
 #include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/stat.h>
 #include <fcntl.h>
 #include <sys/ioctl.h>
+#include <poll.h>
+#include <memory>
 
 #include "Error.hpp"
 #include "Log.hpp"
+#include "Message.hpp"
 
 #pragma once
 
@@ -71,6 +76,34 @@ public:
 	 */
 	void prepare(const string& hostAddress, const string& hostPort, bool bind, int sockType = SOCK_DGRAM);
 
+	/**
+	 * Prepares a unix domain socket.
+	 * On SOCK_SEQPACKET server mode, clients connect and can keep the connection open.
+	 *
+	 * @param path the socket file.
+	 * @param bind true will create the socket file (server mode), false will connect to it (client mode).
+	 * @param sockType SOCK_DGRAM or SOCK_SEQPACKET.
+	 * @throws Error if fails to bind or connect.
+	 */
+	void prepareUnix(const string& path, bool bind, int sockType = SOCK_DGRAM);
+
+	/**
+	 * Restricts the peers of a unix domain server to a list of users,
+	 * checked with SO_PEERCRED for connections and SCM_CREDENTIALS for datagrams.
+	 *
+	 * @param users list of user ids, empty allows everyone.
+	 */
+	void setAllowedUsers(const vector<uid_t>& users);
+
+	/**
+	 * Converts a socket type name into the socket type.
+	 *
+	 * @param type Datagram or SeqPacket.
+	 * @return SOCK_DGRAM or SOCK_SEQPACKET.
+	 * @throws Error if the type is unknown.
+	 */
+	static int str2type(const string& type);
+
 	/**
 	 * Checks if is connected.
 	 *
@@ -96,6 +129,33 @@ public:
 	 */
 	bool receive(string& buffer) noexcept;
 
+	/**
+	 * Reads the pending bytes of a connected socket into a buffer, without blocking.
+	 *
+	 * @param[out] buffer
+	 * @param size buffer size.
+	 * @return the number of bytes read, 0 if nothing is pending, -1 if the connection was closed or failed.
+	 */
+	ssize_t receive(char* buffer, size_t size) noexcept;
+
+	/**
+	 * Retrieves all the pending messages, up to max, without blocking.
+	 * Datagrams are read with recvmmsg into a buffer allocated on first use.
+	 *
+	 * @param[out] buffers The received messages, existing strings are reused.
+	 * @param max maximum number of messages to read.
+	 * @return the number of messages stored in buffers.
+	 */
+	size_t receiveBatch(vector<string>& buffers, size_t max) noexcept;
+
+	/**
+	 * Blocks until there is something to read.
+	 *
+	 * @param milliseconds maximum time to wait.
+	 * @return true if there is something to read, false on timeout, signal or error.
+	 */
+	bool wait(int milliseconds) noexcept;
+
 	/**
 	 * Closes the connection.
 	 */
@@ -111,8 +171,57 @@ private:
 	/// Socket frame buffer.
 	int socketFB = 0;
 
-	/// Time value structure.
-	timeval tv = {0, 0};
+	/// Socket type.
+	int sockType = SOCK_DGRAM;
+
+	/// Unix socket file, only set for unix domain servers.
+	string unixPath;
+
+	/// Connected clients for unix domain SOCK_SEQPACKET servers, up to SOCKET_CLIENTS.
+	vector<int> clients;
+
+	/// Next client to read, every client gets a turn.
+	size_t nextClient = 0;
+
+	/// Users allowed to talk to a unix domain server, empty for everyone.
+	vector<uid_t> allowedUsers;
+
+	/// Slots for batch reads, RECEIVE_BATCH datagrams of DATAGRAM_SIZE.
+	std::unique_ptr<char[]> batchBuffer;
+
+	/// Headers for batch reads, one per slot.
+	vector<mmsghdr> batchHeaders;
+
+	/// Vectors for batch reads, one per slot.
+	vector<iovec> batchParts;
+
+	/**
+	 * Accepts the pending connections, rejecting the ones from users not allowed or over SOCKET_CLIENTS.
+	 */
+	void acceptClients();
+
+	/**
+	 * Reads a single message from a socket, messages from users not allowed are skipped.
+	 *
+	 * @param fd
+	 * @param[out] buffer The received message.
+	 * @return -1 if the connection was closed, 0 if nothing was read, 1 if a message was read.
+	 */
+	int8_t readFrom(int fd, string& buffer) noexcept;
+
+	/**
+	 * Removes the terminator added by send from text messages,
+	 * binary messages carry their lengths and may end with a real zero.
+	 *
+	 * @param[in,out] buffer
+	 */
+	static void trimTerminator(string& buffer) noexcept;
+
+	/**
+	 * @param uid
+	 * @return true if the user is allowed.
+	 */
+	bool isAllowed(uid_t uid) const;
 };
 
 } // namespace
@@ -0,0 +1,147 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      Spectrum.cpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "Spectrum.hpp"
+#include <cmath>
+
+using namespace LEDSpicer::Utilities;
+
+Spectrum::Spectrum(size_t size, uint32_t sampleRate) :
+	fft(size),
+	sampleRate(sampleRate),
+	history(size, 0),
+	ordered(size)
+{
+	for (auto& m : magnitudes)
+		m.assign(size / 2, 0);
+	thread = std::thread(&Spectrum::analyze, this);
+}
+
+Spectrum::~Spectrum() {
+	stop.store(true);
+	thread.join();
+}
+
+void Spectrum::feed(const float* data, size_t frames, uint8_t channels) {
+	float mono[SPECTRUM_CHUNK];
+	while (frames) {
+		size_t count = std::min<size_t>(frames, SPECTRUM_CHUNK);
+		for (size_t f = 0; f < count; ++f, data += channels) {
+			float sample = 0;
+			for (uint8_t c = 0; c < channels; ++c)
+				sample += data[c];
+			mono[f] = sample / channels;
+		}
+		ring.push(mono, count);
+		frames -= count;
+	}
+}
+
+void Spectrum::feed(const int16_t* data, size_t frames, uint8_t channels) {
+	float mono[SPECTRUM_CHUNK];
+	while (frames) {
+		size_t count = std::min<size_t>(frames, SPECTRUM_CHUNK);
+		for (size_t f = 0; f < count; ++f, data += channels) {
+			float sample = 0;
+			for (uint8_t c = 0; c < channels; ++c)
+				sample += data[c];
+			mono[f] = sample / (channels * 32768.f);
+		}
+		ring.push(mono, count);
+		frames -= count;
+	}
+}
+
+const vector<float>& Spectrum::getBands(uint16_t count) {
+	if (middle.load(std::memory_order_acquire) & FRESH) {
+		front = middle.exchange(front, std::memory_order_acq_rel) & ~FRESH;
+		++version;
+	}
+	const vector<float>& current = magnitudes[front];
+	Bands& b = bands[count];
+	if (b.edges.empty())
+		calculateEdges(b, count);
+	if (b.version == version and b.levels.size() == count)
+		return b.levels;
+
+	b.version = version;
+	b.levels.assign(count, 0);
+	for (uint16_t band = 0; band < count; ++band) {
+		float peak = 0;
+		for (uint16_t bin = b.edges[band]; bin < b.edges[band + 1]; ++bin)
+			peak = std::max(peak, current[bin]);
+		if (peak <= 0)
+			continue;
+		float level = (20 * std::log10(peak) + SPECTRUM_FLOOR_DB) * 100 / SPECTRUM_FLOOR_DB;
+		b.levels[band] = std::clamp(level, 0.f, 100.f);
+	}
+	return b.levels;
+}
+
+void Spectrum::analyze() {
+	// A quarter of a window, the thread wakes about twice per half window.
+	auto wait = std::chrono::microseconds(history.size() * 250000 / sampleRate);
+	while (not stop.load()) {
+		drain();
+		if (pending < history.size() / 2) {
+			std::this_thread::sleep_for(wait);
+			continue;
+		}
+		pending = 0;
+		// Oldest sample first.
+		size_t size = history.size();
+		for (size_t c = 0; c < size; ++c)
+			ordered[c] = history[(position + c) & (size - 1)];
+		fft.magnitudes(ordered.data(), magnitudes[back].data());
+		back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & ~FRESH;
+	}
+}
+
+void Spectrum::drain() {
+	float chunk[SPECTRUM_CHUNK];
+	size_t size = history.size();
+	while (size_t count = ring.pop(chunk, SPECTRUM_CHUNK)) {
+		for (size_t c = 0; c < count; ++c) {
+			history[position] = chunk[c];
+			position = (position + 1) & (size - 1);
+		}
+		pending += count;
+	}
+}
+
+void Spectrum::calculateEdges(Bands& b, uint16_t count) const {
+	uint16_t bins = fft.size() / 2;
+	float
+		binWidth = static_cast<float>(sampleRate) / fft.size(),
+		top      = std::min<float>(SPECTRUM_MAX_FREQUENCY, sampleRate / 2.f),
+		ratio    = top / SPECTRUM_MIN_FREQUENCY;
+	b.edges.resize(count + 1);
+	for (uint16_t band = 0; band <= count; ++band) {
+		float frequency = SPECTRUM_MIN_FREQUENCY * std::pow(ratio, static_cast<float>(band) / count);
+		uint16_t bin = std::lround(frequency / binWidth);
+		// Every band gets at least one bin, the low bands are narrower than a bin.
+		if (band and bin <= b.edges[band - 1])
+			bin = b.edges[band - 1] + 1;
+		b.edges[band] = std::min(bin, bins);
+	}
+}
@@ -0,0 +1,169 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      Spectrum.hpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <thread>
+
+#include "FFT.hpp"
+#include "SPSCQueue.hpp"
+
+#pragma once
+
+/// Lowest frequency on the bands.
+#define SPECTRUM_MIN_FREQUENCY 50
+/// Highest frequency on the bands.
+#define SPECTRUM_MAX_FREQUENCY 16000
+/// Level shown as 0, in decibels below full scale.
+#define SPECTRUM_FLOOR_DB      60
+/// Mono samples waiting for the analysis thread.
+#define SPECTRUM_RING          16384
+/// Samples moved at once between the ring and the threads.
+#define SPECTRUM_CHUNK         256
+
+namespace LEDSpicer::Utilities {
+
+/**
+ * LEDSpicer::Utilities::Spectrum
+ *
+ * Analyzes the captured audio on its own thread, every time half a window of new samples
+ * arrives the whole window is transformed.
+ * The capture thread hands the samples over a lock free ring and the magnitudes are handed
+ * to the render thread with a triple buffer, so neither side ever waits for the analysis.
+ * The bands are calculated once per new analysis and shared by everyone asking for the same number of bands.
+ */
+class Spectrum {
+
+public:
+
+	/**
+	 * Starts the analysis thread.
+	 * @param size samples per window, a power of two.
+	 * @param sampleRate
+	 */
+	Spectrum(size_t size, uint32_t sampleRate);
+
+	Spectrum(const Spectrum&) = delete;
+	Spectrum& operator=(const Spectrum&) = delete;
+
+	/**
+	 * Stops the analysis thread.
+	 */
+	virtual ~Spectrum();
+
+	/**
+	 * Adds interleaved samples, the channels are mixed.
+	 * Only one thread can feed, samples that do not fit are dropped.
+	 * @param data samples from -1 to 1.
+	 * @param frames number of samples per channel.
+	 * @param channels
+	 */
+	void feed(const float* data, size_t frames, uint8_t channels);
+
+	/**
+	 * @param data 16 bits samples.
+	 * @param frames number of samples per channel.
+	 * @param channels
+	 */
+	void feed(const int16_t* data, size_t frames, uint8_t channels);
+
+	/**
+	 * Levels of logarithmically spaced bands from the last analysis.
+	 * Only one thread can read.
+	 * @param count number of bands.
+	 * @return the levels, 0 to 100.
+	 */
+	const vector<float>& getBands(uint16_t count);
+
+protected:
+
+	struct Bands {
+		/// Analysis used to calculate the levels.
+		uint32_t version = 0;
+		/// First bin of every band and the end of the last.
+		vector<uint16_t> edges;
+		/// Band levels.
+		vector<float> levels;
+	};
+
+	/// Set on the middle buffer index when it has magnitudes not read yet.
+	static constexpr uint8_t FRESH = 4;
+
+	FFT fft;
+
+	uint32_t sampleRate;
+
+	std::thread thread;
+
+	std::atomic<bool> stop {false};
+
+	/// Samples from the capture thread.
+	SPSCQueue<float, SPECTRUM_RING> ring;
+
+	/// Last samples received, a ring of a window, used by the thread.
+	vector<float> history;
+
+	/// Next history position.
+	size_t position = 0;
+
+	/// Samples received since the last analysis.
+	size_t pending = 0;
+
+	/// Window in order, used by the thread.
+	vector<float> ordered;
+
+	/// Magnitudes triple buffer.
+	array<vector<float>, 3> magnitudes;
+
+	/// Buffer being written by the thread.
+	uint8_t back = 0;
+
+	/// Buffer exchanged between the thread and the reader, with the FRESH flag.
+	std::atomic<uint8_t> middle {1};
+
+	/// Buffer in use by the reader.
+	uint8_t front = 2;
+
+	/// Increased when new magnitudes are in use.
+	uint32_t version = 0;
+
+	/// Bands by number of bands.
+	unordered_map<uint16_t, Bands> bands;
+
+	/**
+	 * Analysis thread loop.
+	 */
+	void analyze();
+
+	/**
+	 * Moves the samples waiting on the ring into the history.
+	 */
+	void drain();
+
+	/**
+	 * Calculates the first bin of every band.
+	 * @param[out] bands
+	 * @param count number of bands.
+	 */
+	void calculateEdges(Bands& bands, uint16_t count) const;
+};
+
+} // namespace
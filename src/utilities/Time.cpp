@@ -31,13 +31,21 @@ Time::Time(float seconds) {
 }
 
 void Time::reset(uint milliseconds) {
-	timeOnExpiration = std::chrono::system_clock::now() + std::chrono::milliseconds(milliseconds);
+	timeOnExpiration = now() + std::chrono::milliseconds(milliseconds);
 }
 
 bool Time::isTime() const {
-	return (std::chrono::system_clock::now() > timeOnExpiration);
+	return (now() > timeOnExpiration);
 }
 
 void Time::setFrameTime() {
-	frameTime = system_clock::now();
+	frameTime = now();
+}
+
+void Time::setVirtualTime(system_clock::time_point time) {
+	virtualTime = time;
+}
+
+system_clock::time_point Time::now() {
+	return virtualTime == system_clock::time_point() ? system_clock::now() : virtualTime;
 }
@@ -64,11 +64,26 @@ public:
 	 */
 	static void setFrameTime();
 
+	/**
+	 * Replaces the system clock with a clock moved by hand, used to replay recordings.
+	 * An empty time point goes back to the system clock.
+	 * @param time the current time.
+	 */
+	static void setVirtualTime(system_clock::time_point time);
+
 protected:
 
 	/// Shared frame anchor — all timers use this as their "now".
 	inline static system_clock::time_point frameTime = system_clock::now();
 
+	/// Current time when the clock is moved by hand, empty for the system clock.
+	inline static system_clock::time_point virtualTime = {};
+
+	/**
+	 * @return the current time.
+	 */
+	static system_clock::time_point now();
+
 	/// Calculated timepoint to finish.
 	system_clock::time_point timeOnExpiration = {};
 
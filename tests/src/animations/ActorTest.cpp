@@ -66,6 +66,55 @@ protected:
 	}
 };
 
+/**
+ * CycleActor
+ * Repeats every 3 frames after a different first frame, counting the calculations.
+ */
+class CycleActor : public Actor {
+
+public:
+
+	CycleActor(
+		StringUMap&           parameters,
+		Group* const          group,
+		const vector<string>& requiredParameters
+	) : Actor(parameters, group, requiredParameters) {}
+
+	uint32_t calculations = 0;
+
+	void restart() override {
+		Actor::restart();
+		position = 0;
+		started  = false;
+	}
+
+protected:
+
+	uint8_t position = 0;
+
+	bool started = false;
+
+	void calculateElements() override {
+		++calculations;
+		if (not started) {
+			started = true;
+			changeElementsColor(Color(255, 255, 255), Color::Filters::Normal, 100);
+			return;
+		}
+		changeElementColor(position % 2, Color(80 * (position + 1), 0, 0), Color::Filters::Normal, 100);
+		changeElementColor(1, Color(0, 200, 0), Color::Filters::Combine, 25 * position);
+		position = position == 2 ? 0 : position + 1;
+	}
+
+	uint32_t getCycleFrames() const override {
+		return 3;
+	}
+
+	uint32_t getWarmupFrames() const override {
+		return 1;
+	}
+};
+
 } // namespace
 
 /**
@@ -520,6 +569,71 @@ TEST(ActorTest, DrawConfig) {
 	EXPECT_NE(output.find("10.00 sec", sec10), string::npos); // 2nd find
 }
 
+TEST(ActorTest, Bake) {
+
+	Group
+		liveGroup("LiveGroup", DEFAULT_COLOR),
+		bakedGroup("BakedGroup", DEFAULT_COLOR);
+	uint8_t live[2] {}, baked[2] {};
+	Element
+		liveElement1("Live1", &live[0], DEFAULT_COLOR, 0, 100),
+		liveElement2("Live2", &live[1], DEFAULT_COLOR, 0, 100),
+		bakedElement1("Baked1", &baked[0], DEFAULT_COLOR, 0, 100),
+		bakedElement2("Baked2", &baked[1], DEFAULT_COLOR, 0, 100);
+	liveGroup.linkElement(&liveElement1);
+	liveGroup.linkElement(&liveElement2);
+	bakedGroup.linkElement(&bakedElement1);
+	bakedGroup.linkElement(&bakedElement2);
+	StringUMap params {
+		{"type",   "Test"},
+		{"group",  "TestGroup"},
+		{"filter", "Normal"}
+	};
+	const vector<string> required {"type", "group", "filter"};
+	CycleActor
+		liveActor(params, &liveGroup, required),
+		bakedActor(params, &bakedGroup, required);
+
+	ASSERT_TRUE(bakedActor.bake());
+	EXPECT_TRUE(bakedActor.isBaked());
+	EXPECT_FALSE(liveActor.isBaked());
+	EXPECT_EQ(bakedActor.calculations, 4u);
+	// Recording leaves the elements alone.
+	EXPECT_EQ(baked[0], 0);
+	EXPECT_EQ(baked[1], 0);
+
+	liveActor.restart();
+	bakedActor.restart();
+	for (uint8_t f = 0; f < 11; ++f) {
+		// The same background before every frame, so combine is replayed against it.
+		liveElement2.setColor(Color(0, 0, 100));
+		bakedElement2.setColor(Color(0, 0, 100));
+		if (f == 7) {
+			liveActor.restart();
+			bakedActor.restart();
+		}
+		liveActor.draw();
+		bakedActor.draw();
+		EXPECT_EQ(live[0], baked[0]) << "frame " << +f;
+		EXPECT_EQ(live[1], baked[1]) << "frame " << +f;
+	}
+	EXPECT_EQ(bakedActor.calculations, 4u);
+}
+
+TEST(ActorTest, BakeNotDeterministic) {
+
+	Group group("TestGroup", DEFAULT_COLOR);
+	StringUMap params {
+		{"type",   "Test"},
+		{"group",  "TestGroup"},
+		{"filter", "Normal"}
+	};
+	const vector<string> required {"type", "group", "filter"};
+	TestActor actor(params, &group, required);
+	EXPECT_FALSE(actor.bake());
+	EXPECT_FALSE(actor.isBaked());
+}
+
 int main(int argc, char **argv) {
 	::testing::InitGoogleTest(&argc, argv);
 	return RUN_ALL_TESTS();
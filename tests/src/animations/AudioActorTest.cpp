@@ -42,6 +42,7 @@ public:
 		// Set mock values; can be overridden in tests.
 		value.l = mockLeft;
 		value.r = mockRight;
+		++peakCalls;
 	}
 
 	// Expose protected members for testing.
@@ -55,9 +56,14 @@ public:
 	using AudioActor::waves;
 	using AudioActor::calculateElements;
 
+	using AudioActor::value;
+
 	// Mock peaks.
 	uint8_t mockLeft  = 0;
 	uint8_t mockRight = 0;
+
+	// Analyses made.
+	inline static uint16_t peakCalls = 0;
 };
 
 class AudioActorTest : public ::testing::Test {
@@ -150,6 +156,66 @@ TEST_F(AudioActorTest, DetectColor) {
 	EXPECT_EQ(actor.detectColor(100, true), Color::getColor("Green"));
 }
 
+TEST_F(AudioActorTest, SharedAnalysis) {
+
+	StringUMap params = {
+		{"mode",    "Single"},
+		{"off",     "Black"},
+		{"low",     "Red"},
+		{"mid",     "Yellow"},
+		{"high",    "Green"},
+		{"channel", "Both"}
+	};
+
+	Group group(defaultColor);
+	for (uint8_t i = 0; i < 10; ++i) group.linkElement(mockElements.at(i));
+	MockAudioActor first(params, &group), second(params, &group);
+	first.mockLeft  = 40;
+	second.mockLeft = 90;
+	MockAudioActor::peakCalls = 0;
+
+	// One analysis per frame, whatever the number of actors.
+	Actor::newFrame();
+	first.calculateElements();
+	second.calculateElements();
+	EXPECT_EQ(MockAudioActor::peakCalls, 1);
+	EXPECT_EQ(second.value.l, 40);
+
+	Actor::newFrame();
+	second.calculateElements();
+	first.calculateElements();
+	EXPECT_EQ(MockAudioActor::peakCalls, 2);
+	EXPECT_EQ(first.value.l, 90);
+}
+
+TEST_F(AudioActorTest, LevelGoesStale) {
+
+	StringUMap params = {
+		{"mode",    "Single"},
+		{"off",     "Black"},
+		{"low",     "Red"},
+		{"mid",     "Yellow"},
+		{"high",    "Green"},
+		{"channel", "Both"}
+	};
+
+	Group group(defaultColor);
+	for (uint8_t i = 0; i < 10; ++i) group.linkElement(mockElements.at(i));
+	MockAudioActor actor(params, &group);
+	actor.mockLeft  = 20;
+	actor.mockRight = 60;
+
+	Actor::newFrame();
+	actor.calculateElements();
+	EXPECT_FLOAT_EQ(AudioActor::getLevel(), 0.6f);
+	// Actors drawn before the analysis see the previous one.
+	Actor::newFrame();
+	EXPECT_FLOAT_EQ(AudioActor::getLevel(), 0.6f);
+	// Nothing analyzed since.
+	Actor::newFrame();
+	EXPECT_FLOAT_EQ(AudioActor::getLevel(), 0);
+}
+
 int main(int argc, char **argv) {
 	Color::loadColors({{"Green", "00FF00"}, {"Red", "FF0000"}, {"Yellow", "00FFFF"}, {"White", "FFFFFF"}, {"Black", "000000"}}, "hex");
 	Log::setLogLevel(LOG_ERR);
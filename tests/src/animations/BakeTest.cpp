@@ -0,0 +1,145 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      BakeTest.cpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+#include "animations/Serpentine.hpp"
+#include "animations/Filler.hpp"
+#include "animations/Pulse.hpp"
+
+using namespace LEDSpicer::Animations;
+using namespace LEDSpicer::Devices;
+using LEDSpicer::Utilities::Color;
+
+/// Frames drawn on every comparison, several cycles of the slowest actor.
+#define BAKE_TEST_FRAMES 2000
+
+/// Frame where both actors restart.
+#define BAKE_TEST_RESTART 1500
+
+class BakeTest : public ::testing::Test {
+
+protected:
+
+	static void SetUpTestSuite() {
+		Color::loadColors({{"Red", "FF0000"}, {"Green", "00FF00"}, {"Blue", "0000FF"}}, "hex");
+		Actor::setFPS(30);
+	}
+
+	/**
+	 * Draws an actor live and a baked copy on groups of the same size, comparing every frame.
+	 * @param parameters
+	 * @param elements group size.
+	 */
+	template <class A>
+	void compare(const StringUMap& parameters, uint16_t elements) {
+
+		static uint16_t groups = 0;
+		const Color defaultColor(255, 255, 255);
+		Group
+			liveGroup("Live" + to_string(groups), defaultColor),
+			bakedGroup("Baked" + to_string(groups++), defaultColor);
+		vector<uint8_t> live(elements * 3), baked(elements * 3);
+		vector<std::unique_ptr<Element>> all;
+		for (uint16_t e = 0; e < elements; ++e) {
+			all.push_back(std::make_unique<Element>("L" + to_string(e), &live[e * 3], defaultColor, 0, 100));
+			liveGroup.linkElement(all.back().get());
+			all.push_back(std::make_unique<Element>("B" + to_string(e), &baked[e * 3], defaultColor, 0, 100));
+			bakedGroup.linkElement(all.back().get());
+		}
+
+		StringUMap liveParameters(parameters), bakedParameters(parameters);
+		A
+			liveActor(liveParameters, &liveGroup),
+			bakedActor(bakedParameters, &bakedGroup);
+		ASSERT_TRUE(bakedActor.bake());
+		liveActor.restart();
+		bakedActor.restart();
+
+		for (uint16_t f = 0; f < BAKE_TEST_FRAMES; ++f) {
+			std::fill(live.begin(), live.end(), 0);
+			std::fill(baked.begin(), baked.end(), 0);
+			if (f == BAKE_TEST_RESTART) {
+				liveActor.restart();
+				bakedActor.restart();
+			}
+			liveActor.draw();
+			bakedActor.draw();
+			ASSERT_EQ(live, baked) << "frame " << f;
+		}
+	}
+
+	/**
+	 * @param type
+	 * @param speed
+	 * @param direction
+	 * @param bouncer
+	 * @return the parameters shared by every actor.
+	 */
+	static StringUMap base(const string& type, const string& speed, const string& direction, const string& bouncer) {
+		return {
+			{"type",      type},
+			{"group",     "Test"},
+			{"filter",    "Normal"},
+			{"speed",     speed},
+			{"direction", direction},
+			{"bouncer",   bouncer}
+		};
+	}
+};
+
+TEST_F(BakeTest, Serpentine) {
+	for (string direction : {"Forward", "Backward"}) {
+		for (string bouncer : {"True", "False"}) {
+			StringUMap parameters(base("Serpentine", "Normal", direction, bouncer));
+			parameters["color"] = "Red";
+			SCOPED_TRACE(direction + " bouncer " + bouncer);
+			compare<Serpentine>(parameters, 9);
+			// The tail needs a warmup before the cycle repeats.
+			parameters["tailColor"]     = "Blue";
+			parameters["tailLength"]    = "4";
+			parameters["tailIntensity"] = "80";
+			compare<Serpentine>(parameters, 9);
+		}
+	}
+}
+
+TEST_F(BakeTest, Filler) {
+	for (string mode : {"Normal", "Wave", "Curtain"}) {
+		for (string bouncer : {"True", "False"}) {
+			StringUMap parameters(base("Filler", "Fast", "Forward", bouncer));
+			parameters["mode"]   = mode;
+			parameters["colors"] = "Red,Green";
+			SCOPED_TRACE(mode + " bouncer " + bouncer);
+			compare<Filler>(parameters, 7);
+		}
+	}
+}
+
+TEST_F(BakeTest, Pulse) {
+	for (string bouncer : {"True", "False"}) {
+		StringUMap parameters(base("Pulse", "Normal", "Forward", bouncer));
+		parameters["colors"] = "Red,Green,Blue";
+		SCOPED_TRACE("bouncer " + bouncer);
+		compare<Pulse>(parameters, 3);
+	}
+}
@@ -0,0 +1,104 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      ClientTest.cpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include "client/Client.hpp"
+#include "client/ledspicer-client.h"
+#include "utilities/Messages.hpp"
+
+using namespace LEDSpicer;
+using namespace LEDSpicer::Utilities;
+
+const string testPort = "15556";
+
+TEST(ClientTest, SendsRequests) {
+	Messages server(testPort);
+	Client client(testPort);
+	ASSERT_TRUE(client.isConnected());
+
+	EXPECT_TRUE(client.loadProfileByEmulator("1943", "arcade", FLAG_NO_ROTATOR));
+	EXPECT_TRUE(client.setElement("P1_B1", "Red"));
+	EXPECT_TRUE(client.finishLastProfile());
+
+	sleep_for(std::chrono::milliseconds(100));
+
+	ASSERT_TRUE(server.read());
+	Message msg = server.getMessage();
+	EXPECT_EQ(msg.getType(), Message::Types::LoadProfileByEmulator);
+	EXPECT_EQ(msg.getFlags(), FLAG_NO_ROTATOR);
+	EXPECT_EQ(msg.getData(), vector<string>({"1943", "arcade"}));
+
+	msg = server.getMessage();
+	EXPECT_EQ(msg.getType(), Message::Types::SetElement);
+	EXPECT_EQ(msg.getData(), vector<string>({"P1_B1", "Red", "Normal"}));
+
+	msg = server.getMessage();
+	EXPECT_EQ(msg.getType(), Message::Types::FinishLastProfile);
+	EXPECT_TRUE(msg.getData().empty());
+	EXPECT_FALSE(server.hasMessages());
+}
+
+TEST(ClientTest, UnixSocket) {
+	const string path = "/tmp/ledspicer_client_test";
+	Messages server("", path, SOCK_SEQPACKET);
+	Client client("", path, SOCK_SEQPACKET);
+
+	EXPECT_TRUE(client.clearGroup("Player1"));
+	sleep_for(std::chrono::milliseconds(100));
+
+	ASSERT_TRUE(server.read());
+	Message msg = server.getMessage();
+	EXPECT_EQ(msg.getType(), Message::Types::ClearGroup);
+	EXPECT_EQ(msg.getData(), vector<string>({"Player1"}));
+}
+
+TEST(ClientTest, CInterface) {
+	Messages server(testPort);
+	ledspicer_client* client = ledspicer_client_open(testPort.c_str(), nullptr, 0);
+	ASSERT_NE(client, nullptr);
+
+	EXPECT_EQ(ledspicer_client_type("Unknown"), -1);
+	int type = ledspicer_client_type("LoadProfile");
+	ASSERT_EQ(type, static_cast<int>(Message::Types::LoadProfile));
+
+	const char* profiles[] = {"arcade/1943", "arcade"};
+	uint8_t flags = ledspicer_client_flags("NO_INPUTS|REPLACE");
+	EXPECT_EQ(flags, FLAG_NO_INPUTS | FLAG_REPLACE);
+	EXPECT_EQ(ledspicer_client_send(client, type, flags, profiles, 2), 1);
+	ledspicer_client_close(client);
+
+	sleep_for(std::chrono::milliseconds(100));
+
+	ASSERT_TRUE(server.read());
+	Message msg = server.getMessage();
+	EXPECT_EQ(msg.getType(), Message::Types::LoadProfile);
+	EXPECT_EQ(msg.getFlags(), FLAG_NO_INPUTS | FLAG_REPLACE);
+	EXPECT_EQ(msg.getData(), vector<string>({"arcade/1943", "arcade"}));
+
+	// Missing server.
+	EXPECT_EQ(ledspicer_client_open(nullptr, "/tmp/ledspicer_client_missing", 0), nullptr);
+}
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
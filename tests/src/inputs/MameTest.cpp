@@ -0,0 +1,132 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      MameTest.cpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+#include "inputs/Mame.hpp"
+
+using namespace LEDSpicer::Inputs;
+using namespace LEDSpicer::Devices;
+using LEDSpicer::Utilities::Color;
+
+namespace LEDSpicer::Inputs {
+
+/**
+ * TestMame
+ * Exposes the Mame parser without connecting to MAME.
+ */
+class TestMame : public Mame {
+
+public:
+
+	TestMame(StringUMap& parameters, ItemPtrUMap& inputMaps) : Mame(parameters, inputMaps) {}
+
+	bool feed(const string& data) {
+		return parse(data.data(), data.size());
+	}
+
+	void apply() {
+		applyChanges();
+	}
+
+	size_t getChanged() const {
+		return changed.size();
+	}
+
+	bool isOn(const string& output) const {
+		return isControlled(itemIds.at(output));
+	}
+};
+
+} // namespace
+
+class MameTest : public ::testing::Test {
+
+protected:
+
+	Color color {255, 0, 0};
+
+	Element
+		element0 {"E0", nullptr, color, 0, 100},
+		element1 {"E1", nullptr, color, 0, 100};
+
+	StringUMap parameters;
+
+	std::unique_ptr<TestMame> mame;
+
+	void SetUp() override {
+		ItemPtrUMap maps {
+			{"lamp0", new Element::Item(&element0, &color, Color::Filters::Normal)},
+			{"lamp1", new Element::Item(&element1, &color, Color::Filters::Normal)}
+		};
+		mame = std::make_unique<TestMame>(parameters, maps);
+	}
+};
+
+TEST_F(MameTest, LineSplitBetweenReads) {
+	EXPECT_TRUE(mame->feed("lamp0 = "));
+	EXPECT_EQ(mame->getChanged(), 0);
+	EXPECT_TRUE(mame->feed("1\r\n"));
+	EXPECT_EQ(mame->getChanged(), 1);
+	mame->apply();
+	EXPECT_TRUE(mame->isOn("lamp0"));
+	EXPECT_FALSE(mame->isOn("lamp1"));
+	EXPECT_EQ(mame->getChanged(), 0);
+
+	// Split inside the name.
+	EXPECT_TRUE(mame->feed("la"));
+	EXPECT_TRUE(mame->feed("mp0 = 0\r\n"));
+	mame->apply();
+	EXPECT_FALSE(mame->isOn("lamp0"));
+}
+
+TEST_F(MameTest, LastUpdateOfTheFrameWins) {
+	EXPECT_TRUE(mame->feed("lamp0 = 1\r\nlamp1 = 1\r\nlamp0 = 0\r\n"));
+	EXPECT_EQ(mame->getChanged(), 2);
+	mame->apply();
+	EXPECT_FALSE(mame->isOn("lamp0"));
+	EXPECT_TRUE(mame->isOn("lamp1"));
+
+	EXPECT_TRUE(mame->feed("lamp1 = 0\r\nlamp1 = 1\r\n"));
+	EXPECT_EQ(mame->getChanged(), 1);
+	mame->apply();
+	EXPECT_TRUE(mame->isOn("lamp1"));
+}
+
+TEST_F(MameTest, InvalidLines) {
+	// Names longer than MAME_NAME_SIZE are ignored.
+	EXPECT_TRUE(mame->feed(string(MAME_NAME_SIZE, 'x') + "lamp0 = 1\r\n"));
+	// Unknown outputs and repeated equal signs.
+	EXPECT_TRUE(mame->feed("lamp9 = 1\r\nlamp0 = = 1\r\nlamp0\r\n"));
+	EXPECT_EQ(mame->getChanged(), 0);
+	// The parser recovers on the next line.
+	EXPECT_TRUE(mame->feed("lamp0 = 1\r\n"));
+	EXPECT_EQ(mame->getChanged(), 1);
+	mame->apply();
+	EXPECT_TRUE(mame->isOn("lamp0"));
+	// A missing value is off.
+	EXPECT_TRUE(mame->feed("lamp0 =\r\n"));
+	mame->apply();
+	EXPECT_FALSE(mame->isOn("lamp0"));
+	// MAME stopped.
+	EXPECT_FALSE(mame->feed("mame_stop = 1\r\n"));
+}
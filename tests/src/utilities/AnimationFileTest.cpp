@@ -0,0 +1,79 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      AnimationFileTest.cpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+#include "utilities/AnimationFile.hpp"
+
+using namespace LEDSpicer::Utilities;
+
+static const string animationPath("/tmp/ledspicer-animation-test.lsa");
+
+TEST(AnimationFileTest, WriteAndDecode) {
+	vector<vector<uint8_t>> frames {
+		// Repeated colors, stored as runs.
+		vector<uint8_t>(3 * 40, 7),
+		// Every element different, stored raw.
+		{1, 2, 3, 4, 5, 6, 7, 8, 9},
+		// Shorter frame.
+		{255, 0, 0}
+	};
+	AnimationFile::write(animationPath, frames, 30);
+	AnimationFile animation(animationPath);
+	EXPECT_EQ(animation.getFrames(), 3u);
+	EXPECT_EQ(animation.getElements(), 40);
+	EXPECT_EQ(animation.getFPS(), 30);
+
+	vector<uint8_t> rgb(animation.getElements() * AnimationFile::CHANNELS);
+	for (uint32_t f = 0; f < frames.size(); ++f) {
+		uint16_t count = animation.decode(f, rgb.data());
+		ASSERT_EQ(count * AnimationFile::CHANNELS, frames[f].size());
+		EXPECT_TRUE(std::equal(frames[f].begin(), frames[f].end(), rgb.begin()));
+	}
+	// Header, index and the 40 elements in one run.
+	std::ifstream file(animationPath, std::ios::binary | std::ios::ate);
+	EXPECT_EQ(file.tellg(), 16 + 4 * 4 + (3 + 4) + (3 + 9) + (3 + 3));
+}
+
+TEST(AnimationFileTest, LongRuns) {
+	vector<vector<uint8_t>> frames {vector<uint8_t>(3 * 600, 9)};
+	frames[0][3 * 599] = 1;
+	AnimationFile::write(animationPath, frames, 0);
+	AnimationFile animation(animationPath);
+	vector<uint8_t> rgb(600 * AnimationFile::CHANNELS);
+	EXPECT_EQ(animation.decode(0, rgb.data()), 600);
+	EXPECT_EQ(rgb, frames[0]);
+}
+
+TEST(AnimationFileTest, Invalid) {
+	EXPECT_THROW(AnimationFile("/tmp/ledspicer-missing.lsa"), Error);
+	AnimationFile::write(animationPath, {{1, 2, 3}}, 0);
+	// Cut the last byte.
+	string content;
+	{
+		std::ifstream file(animationPath, std::ios::binary);
+		content.assign(std::istreambuf_iterator<char>(file), {});
+	}
+	std::ofstream(animationPath, std::ios::binary | std::ios::trunc) << content.substr(0, content.size() - 1);
+	EXPECT_THROW(AnimationFile{animationPath}, Error);
+	EXPECT_THROW(AnimationFile::write(animationPath, {}, 0), Error);
+}
@@ -0,0 +1,75 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      AudioLevelsTest.cpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+#include <random>
+#include "utilities/AudioLevels.hpp"
+
+using namespace LEDSpicer::Utilities;
+
+static void expectSame(const AudioLevels::Levels& a, const AudioLevels::Levels& b) {
+	EXPECT_EQ(a.peakL, b.peakL);
+	EXPECT_EQ(a.peakR, b.peakR);
+	EXPECT_EQ(a.rmsL,  b.rmsL);
+	EXPECT_EQ(a.rmsR,  b.rmsR);
+}
+
+TEST(AudioLevelsTest, S16) {
+	// Left square wave at half scale, right silent except one full negative sample.
+	vector<int16_t> samples(2 * 100, 0);
+	for (size_t f = 0; f < 100; ++f)
+		samples[f * 2] = f % 2 ? 16384 : -16384;
+	samples[2 * 57 + 1] = -32768;
+	AudioLevels::Levels levels = AudioLevels::measure(samples.data(), 100);
+	EXPECT_FLOAT_EQ(levels.peakL, 16384 / S16_FULL_SCALE);
+	EXPECT_FLOAT_EQ(levels.rmsL,  16384 / S16_FULL_SCALE);
+	EXPECT_FLOAT_EQ(levels.peakR, 32768 / S16_FULL_SCALE);
+	EXPECT_FLOAT_EQ(levels.rmsR,  32768 / S16_FULL_SCALE / 10);
+}
+
+TEST(AudioLevelsTest, Float) {
+	vector<float> samples {0.5f, -0.25f, -0.5f, 0.25f, 0.5f, -0.25f};
+	AudioLevels::Levels levels = AudioLevels::measure(samples.data(), 3);
+	EXPECT_FLOAT_EQ(levels.peakL, 0.5f);
+	EXPECT_FLOAT_EQ(levels.peakR, 0.25f);
+	EXPECT_FLOAT_EQ(levels.rmsL,  0.5f);
+	EXPECT_FLOAT_EQ(levels.rmsR,  0.25f);
+	expectSame(AudioLevels::measure(samples.data(), 0), AudioLevels::Levels());
+}
+
+TEST(AudioLevelsTest, SameAsScalar) {
+	std::mt19937 random(7);
+	std::uniform_int_distribution<int> s16(-32768, 32767);
+	std::uniform_real_distribution<float> f32(-1.2f, 1.2f);
+	// Sizes around the vector width check the tails.
+	for (size_t frames : {1, 3, 4, 5, 800, 1601}) {
+		vector<int16_t> integers(frames * 2);
+		vector<float> floats(frames * 2);
+		for (size_t c = 0; c < frames * 2; ++c) {
+			integers[c] = s16(random);
+			floats[c]   = f32(random);
+		}
+		expectSame(AudioLevels::measure(integers.data(), frames), AudioLevels::measureScalar(integers.data(), frames));
+		expectSame(AudioLevels::measure(floats.data(), frames), AudioLevels::measureScalar(floats.data(), frames));
+	}
+}
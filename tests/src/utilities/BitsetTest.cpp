@@ -0,0 +1,97 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      BitsetTest.cpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+#include "utilities/Bitset.hpp"
+
+using namespace LEDSpicer::Utilities;
+
+TEST(BitsetTest, SetTestReset) {
+	Bitset bits(70);
+	EXPECT_EQ(bits.size(), 70u);
+	EXPECT_FALSE(bits.any());
+	bits.set(0);
+	bits.set(64);
+	bits.set(69);
+	EXPECT_TRUE(bits.test(0));
+	EXPECT_TRUE(bits.test(64));
+	EXPECT_FALSE(bits.test(1));
+	EXPECT_FALSE(bits.test(500));
+	EXPECT_EQ(bits.count(), 3u);
+	bits.reset(64);
+	bits.reset(500);
+	EXPECT_FALSE(bits.test(64));
+	EXPECT_EQ(bits.count(), 2u);
+	bits.clear();
+	EXPECT_FALSE(bits.any());
+	EXPECT_EQ(bits.size(), 70u);
+}
+
+TEST(BitsetTest, GrowsAndShrinks) {
+	Bitset bits;
+	bits.set(130);
+	EXPECT_EQ(bits.size(), 131u);
+	EXPECT_TRUE(bits.test(130));
+	bits.set(10);
+	bits.resize(100);
+	EXPECT_FALSE(bits.test(130));
+	// Bits dropped by the shrink stay off.
+	bits.resize(131);
+	EXPECT_FALSE(bits.test(130));
+	EXPECT_TRUE(bits.test(10));
+	bits.set(70);
+	bits.resize(65);
+	bits.resize(128);
+	EXPECT_FALSE(bits.test(70));
+}
+
+TEST(BitsetTest, SetOperations) {
+	Bitset on(200), blinking(130);
+	on.set(3);
+	blinking.set(3);
+	blinking.set(65);
+	blinking.set(129);
+	on.set(blinking);
+	EXPECT_EQ(on.count(), 3u);
+	EXPECT_TRUE(on.test(129));
+	on.set(150);
+	on.reset(blinking);
+	EXPECT_EQ(on.count(), 1u);
+	EXPECT_TRUE(on.test(150));
+}
+
+TEST(BitsetTest, ForEachInOrder) {
+	Bitset bits(300);
+	vector<size_t> expected {1, 63, 64, 200, 299}, found;
+	for (size_t bit : expected)
+		bits.set(bit);
+	bits.forEach([&](size_t bit) {
+		found.push_back(bit);
+	});
+	EXPECT_EQ(found, expected);
+	// Clearing while iterating.
+	bits.forEach([&](size_t bit) {
+		bits.reset(bit);
+	});
+	EXPECT_FALSE(bits.any());
+}
@@ -0,0 +1,135 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      ExpressionTest.cpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+#include "utilities/Expression.hpp"
+
+using namespace LEDSpicer::Utilities;
+
+static float evaluate(const string& source, const Expression::Inputs& inputs = {}) {
+	Expression expression(source);
+	vector<float> output(1);
+	expression.evaluate(inputs, output);
+	return output[0];
+}
+
+TEST(ExpressionTest, Arithmetic) {
+	EXPECT_FLOAT_EQ(evaluate("1 + 2 * 3"), 7);
+	EXPECT_FLOAT_EQ(evaluate("(1 + 2) * 3"), 9);
+	EXPECT_FLOAT_EQ(evaluate("10 - 4 - 3"), 3);
+	EXPECT_FLOAT_EQ(evaluate("8 / 4 / 2"), 1);
+	EXPECT_FLOAT_EQ(evaluate("2 ^ 3 ^ 2"), 512);
+	EXPECT_FLOAT_EQ(evaluate("-2 ^ 2"), -4);
+	EXPECT_FLOAT_EQ(evaluate("-7 % 3"), 2);
+	EXPECT_FLOAT_EQ(evaluate("1 < 2"), 1);
+	EXPECT_FLOAT_EQ(evaluate("2 <= 1"), 0);
+	EXPECT_FLOAT_EQ(evaluate("1 + 1 >= 2"), 1);
+	EXPECT_FLOAT_EQ(evaluate(".5 * 4"), 2);
+}
+
+TEST(ExpressionTest, Functions) {
+	EXPECT_NEAR(evaluate("sin(pi / 2)"), 1, 1e-6);
+	EXPECT_NEAR(evaluate("cos(pi)"), -1, 1e-6);
+	EXPECT_FLOAT_EQ(evaluate("abs(-3)"), 3);
+	EXPECT_FLOAT_EQ(evaluate("floor(2.7)"), 2);
+	EXPECT_FLOAT_EQ(evaluate("fract(2.25)"), 0.25);
+	EXPECT_FLOAT_EQ(evaluate("sqrt(16)"), 4);
+	EXPECT_FLOAT_EQ(evaluate("pow(2, 10)"), 1024);
+	EXPECT_FLOAT_EQ(evaluate("min(3, max(1, 2))"), 2);
+	EXPECT_FLOAT_EQ(evaluate("step(0.5, 0.7)"), 1);
+	EXPECT_FLOAT_EQ(evaluate("step(0.5, 0.2)"), 0);
+	EXPECT_FLOAT_EQ(evaluate("clamp(5, 0, 1)"), 1);
+	EXPECT_FLOAT_EQ(evaluate("mix(2, 4, 0.25)"), 2.5);
+}
+
+TEST(ExpressionTest, ConstantsAreFolded) {
+	EXPECT_EQ(Expression("1 + 2 * sin(0) - max(3, 4)").getSize(), 1u);
+	// x * 2 + 1, only the variable stays.
+	EXPECT_EQ(Expression("x * (1 + 1) + 1").getSize(), 5u);
+}
+
+TEST(ExpressionTest, Variables) {
+	Expression expression("i + n * 10 + x * 100 + t * 1000 + f * 10000 + audio * 100000");
+	vector<float> output(3);
+	expression.evaluate({0.5, 2, 0.25}, output);
+	const float common = 30 + 500 + 20000 + 25000;
+	EXPECT_FLOAT_EQ(output[0], common);
+	EXPECT_FLOAT_EQ(output[1], common + 1 + 50);
+	EXPECT_FLOAT_EQ(output[2], common + 2 + 100);
+
+	// One element is at the start.
+	output.resize(1);
+	Expression("x").evaluate({}, output);
+	EXPECT_FLOAT_EQ(output[0], 0);
+}
+
+TEST(ExpressionTest, Random) {
+	Expression
+		a("rand", 5),
+		b("rand", 5);
+	vector<float> first(64), second(64);
+	a.evaluate({}, first);
+	b.evaluate({}, second);
+	EXPECT_EQ(first, second);
+	for (float v : first) {
+		EXPECT_GE(v, 0);
+		EXPECT_LE(v, 1);
+	}
+	a.evaluate({}, second);
+	EXPECT_NE(first, second);
+}
+
+TEST(ExpressionTest, Noise) {
+	Expression expression("noise(x * 10)", 3);
+	vector<float> output(1001);
+	expression.evaluate({}, output);
+	for (size_t c = 0; c < output.size(); ++c) {
+		EXPECT_GE(output[c], 0);
+		EXPECT_LE(output[c], 1);
+		// Smooth, small steps between neighbors.
+		if (c) {
+			EXPECT_LT(std::fabs(output[c] - output[c - 1]), 0.02);
+		}
+	}
+	// The seed changes the noise.
+	vector<float> other(output.size());
+	Expression("noise(x * 10)", 4).evaluate({}, other);
+	EXPECT_NE(output, other);
+}
+
+TEST(ExpressionTest, Invalid) {
+	EXPECT_THROW(Expression(""), Error);
+	EXPECT_THROW(Expression("1 +"), Error);
+	EXPECT_THROW(Expression("(1 + 2"), Error);
+	EXPECT_THROW(Expression("1 2"), Error);
+	EXPECT_THROW(Expression("y"), Error);
+	EXPECT_THROW(Expression("foo(1)"), Error);
+	EXPECT_THROW(Expression("min(1)"), Error);
+	EXPECT_THROW(Expression("sin(1, 2)"), Error);
+	EXPECT_THROW(Expression("1 $ 2"), Error);
+	// Too deep for the stack.
+	string deep("x");
+	for (uint8_t c = 0; c < EXPRESSION_STACK; ++c)
+		deep = "x + (" + deep + ")";
+	EXPECT_THROW(Expression{deep}, Error);
+}
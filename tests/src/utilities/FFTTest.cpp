@@ -0,0 +1,53 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      FFTTest.cpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include "utilities/FFT.hpp"
+
+using namespace LEDSpicer::Utilities;
+
+TEST(FFTTest, SineOnBin) {
+	FFT fft(256);
+	vector<float> samples(256), magnitudes(128);
+	for (size_t s = 0; s < samples.size(); ++s)
+		samples[s] = 0.5f * std::sin(2 * M_PI * 16 * s / samples.size());
+	fft.magnitudes(samples.data(), magnitudes.data());
+	EXPECT_NEAR(magnitudes[16], 0.5f, 0.01f);
+	// The window spreads the peak only to the next bins.
+	EXPECT_LT(magnitudes[10], 0.01f);
+	EXPECT_LT(magnitudes[22], 0.01f);
+}
+
+TEST(FFTTest, Silence) {
+	FFT fft(64);
+	vector<float> samples(64, 0), magnitudes(32, 1);
+	fft.magnitudes(samples.data(), magnitudes.data());
+	for (float m : magnitudes)
+		EXPECT_FLOAT_EQ(m, 0);
+}
+
+TEST(FFTTest, InvalidSize) {
+	EXPECT_THROW(FFT(100), Error);
+	EXPECT_THROW(FFT(1), Error);
+}
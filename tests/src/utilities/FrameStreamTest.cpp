@@ -0,0 +1,143 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      FrameStreamTest.cpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include "utilities/FrameStream.hpp"
+
+using namespace LEDSpicer::Utilities;
+
+static const string streamPath("/tmp/ledspicer-stream-test.sock");
+
+static int subscribe() {
+	sockaddr_un address {};
+	address.sun_family = AF_UNIX;
+	streamPath.copy(address.sun_path, streamPath.size());
+	int fd = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+	if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1) {
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+static string receive(int fd) {
+	char buffer[DATAGRAM_SIZE];
+	ssize_t r = recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+	return r > 0 ? string(buffer, r) : "";
+}
+
+TEST(FrameStreamTest, DeltaRoundTrip) {
+	vector<uint8_t> previous(200, 10), current(previous);
+	current[0]   = 1;
+	current[3]   = 2;
+	current[100] = 3;
+	current[199] = 4;
+	string delta;
+	ASSERT_TRUE(FrameStream::encodeDelta(previous, current, delta));
+	// Close changes share a run, 0 and 3 in one, 100 and 199 alone.
+	EXPECT_EQ(delta.size(), 3 * 4 + 4 + 1 + 1u);
+	ASSERT_TRUE(FrameStream::applyDelta(previous, reinterpret_cast<const uint8_t*>(delta.data()), delta.size()));
+	EXPECT_EQ(previous, current);
+}
+
+TEST(FrameStreamTest, DeltaOfEqualFramesIsEmpty) {
+	vector<uint8_t> frame(50, 7);
+	string delta;
+	EXPECT_TRUE(FrameStream::encodeDelta(frame, frame, delta));
+	EXPECT_TRUE(delta.empty());
+}
+
+TEST(FrameStreamTest, DeltaLongUnchangedArea) {
+	vector<uint8_t> previous(200000, 0), current(previous);
+	current[150000] = 255;
+	string delta;
+	ASSERT_TRUE(FrameStream::encodeDelta(previous, current, delta));
+	ASSERT_TRUE(FrameStream::applyDelta(previous, reinterpret_cast<const uint8_t*>(delta.data()), delta.size()));
+	EXPECT_EQ(previous, current);
+}
+
+TEST(FrameStreamTest, DeltaRejected) {
+	vector<uint8_t> previous(10, 0), current(10, 1), other(11, 0);
+	string delta;
+	EXPECT_FALSE(FrameStream::encodeDelta(previous, other, delta));
+	delta.clear();
+	EXPECT_FALSE(FrameStream::encodeDelta(previous, current, delta, current.size()));
+	const uint8_t invalid[] = {5, 0, 10, 0, 1};
+	EXPECT_FALSE(FrameStream::applyDelta(previous, invalid, sizeof(invalid)));
+}
+
+TEST(FrameStreamTest, Subscription) {
+	FrameStream stream(streamPath, 30);
+	stream.setMetadata("device\tTest\t0\t32\n");
+	int fd = subscribe();
+	ASSERT_GE(fd, 0);
+
+	vector<uint8_t> frame(32, 1), received;
+	stream.publish(frame);
+	EXPECT_EQ(stream.getSubscribers(), 1u);
+	EXPECT_EQ(receive(fd), "Mdevice\tTest\t0\t32\n");
+
+	string packet(receive(fd));
+	ASSERT_EQ(packet.size(), 1 + 4 + frame.size());
+	EXPECT_EQ(packet[0], STREAM_KEYFRAME);
+	received.assign(packet.begin() + 5, packet.end());
+	EXPECT_EQ(received, frame);
+
+	frame[2] = 9;
+	stream.publish(frame);
+	packet = receive(fd);
+	ASSERT_GE(packet.size(), 5u);
+	EXPECT_EQ(packet[0], STREAM_DELTA);
+	EXPECT_EQ(packet[1], 2);
+	EXPECT_TRUE(FrameStream::applyDelta(received, reinterpret_cast<const uint8_t*>(packet.data()) + 5, packet.size() - 5));
+	EXPECT_EQ(received, frame);
+
+	// 10 fps out of 30 gets every third frame.
+	ASSERT_EQ(send(fd, "10", 2, 0), 2);
+	uint8_t packets = 0;
+	for (uint8_t c = 0; c < 9; ++c) {
+		stream.publish(frame);
+		if (not receive(fd).empty())
+			++packets;
+	}
+	EXPECT_EQ(packets, 3);
+
+	close(fd);
+	stream.publish(frame);
+	EXPECT_EQ(stream.getSubscribers(), 0u);
+}
+
+TEST(FrameStreamTest, SlowSubscriberLosesFrames) {
+	FrameStream stream(streamPath, 60);
+	int fd = subscribe();
+	ASSERT_GE(fd, 0);
+	vector<uint8_t> frame(4096);
+	// Never read, the socket buffer fills and publish keeps going.
+	for (uint16_t c = 0; c < 2000; ++c) {
+		std::fill(frame.begin(), frame.end(), c & 0xFF);
+		stream.publish(frame);
+	}
+	EXPECT_EQ(stream.getSubscribers(), 1u);
+	string packet(receive(fd));
+	EXPECT_EQ(packet[0], STREAM_METADATA);
+	close(fd);
+}
@@ -0,0 +1,84 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      KeyframeAnimationTest.cpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+#include "utilities/KeyframeAnimation.hpp"
+
+using namespace LEDSpicer::Utilities;
+
+/// A dot running over 100 elements.
+static vector<vector<uint8_t>> makeFrames(uint32_t total) {
+	vector<vector<uint8_t>> frames;
+	for (uint32_t f = 0; f < total; ++f) {
+		vector<uint8_t> frame(100 * KeyframeAnimation::CHANNELS, 10);
+		frame[(f % 100) * KeyframeAnimation::CHANNELS] = 255;
+		frames.push_back(frame);
+	}
+	return frames;
+}
+
+static void expectFrame(const KeyframeAnimation& animation, uint32_t frame, const vector<uint8_t>& expected, uint32_t& decoded) {
+	vector<uint8_t> rgb(animation.getElements() * KeyframeAnimation::CHANNELS);
+	static vector<uint8_t> previous;
+	// Keep the previous contents so continuing from the decoded frame is tested.
+	if (previous.size() == rgb.size())
+		rgb = previous;
+	uint16_t count = animation.decode(frame, rgb.data(), decoded);
+	ASSERT_EQ(count * KeyframeAnimation::CHANNELS, expected.size());
+	EXPECT_TRUE(std::equal(expected.begin(), expected.end(), rgb.begin())) << "frame " << frame;
+	EXPECT_EQ(decoded, frame);
+	previous = rgb;
+}
+
+TEST(KeyframeAnimationTest, ForwardBackwardAndSeek) {
+	auto frames(makeFrames(300));
+	KeyframeAnimation animation;
+	for (auto& frame : frames)
+		animation.add(frame);
+	animation.shrink();
+	EXPECT_EQ(animation.getFrames(), 300u);
+	EXPECT_EQ(animation.getElements(), 100);
+
+	uint32_t decoded = KeyframeAnimation::NO_FRAME;
+	for (uint32_t f = 0; f < 300; ++f)
+		expectFrame(animation, f, frames[f], decoded);
+	for (uint32_t f = 300; f--;)
+		expectFrame(animation, f, frames[f], decoded);
+	for (uint32_t f : {150u, 3u, 299u, 31u, 32u, 33u, 0u})
+		expectFrame(animation, f, frames[f], decoded);
+
+	// Two changes per frame instead of the whole frame.
+	EXPECT_LT(animation.getMemory() * 10, 300 * 100 * 3u);
+}
+
+TEST(KeyframeAnimationTest, SizeChanges) {
+	vector<vector<uint8_t>> frames {{1, 2, 3, 4, 5, 6}, {1, 2, 3}, {1, 2, 3, 4, 5, 6}, {1, 2, 3, 4, 5, 7}, {9, 9, 9, 9, 9, 9}};
+	KeyframeAnimation animation;
+	for (auto& frame : frames)
+		animation.add(frame);
+	EXPECT_EQ(animation.getElements(), 2);
+	uint32_t decoded = KeyframeAnimation::NO_FRAME;
+	for (uint32_t f = 0; f < frames.size(); ++f)
+		expectFrame(animation, f, frames[f], decoded);
+	expectFrame(animation, 1, frames[1], decoded);
+}
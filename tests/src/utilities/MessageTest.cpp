@@ -153,6 +153,163 @@ TEST_F(MessageTest, FlagConversions) {
 }
 
 // Main function for running tests
+TEST_F(MessageTest, BinaryRoundTrip) {
+	Message m(Message::Types::SetElement);
+	m.setFlags(FLAG_NO_INPUTS);
+	m.addData("elem1");
+	m.addId(7);
+	m.addData("Normal");
+
+	string packed = m.toBinary();
+	EXPECT_TRUE(Message::isBinary(packed));
+	EXPECT_EQ(static_cast<uint8_t>(packed[0]), BINARY_MAGIC);
+	EXPECT_EQ(packed[1], BINARY_VERSION);
+
+	Message r;
+	ASSERT_TRUE(Message::fromBinary(packed, r));
+	EXPECT_EQ(r.getType(), Message::Types::SetElement);
+	EXPECT_EQ(r.getFlags(), FLAG_NO_INPUTS);
+	ASSERT_EQ(r.getData().size(), 3);
+	EXPECT_EQ(r.getData()[0], "elem1");
+	EXPECT_EQ(r.getData()[2], "Normal");
+	EXPECT_EQ(r.getId(0), NO_ID);
+	EXPECT_EQ(r.getId(1), 7);
+	EXPECT_EQ(r.getId(2), NO_ID);
+
+	// Text messages are not binary.
+	EXPECT_FALSE(Message::isBinary(m.toString()));
+}
+
+TEST_F(MessageTest, BinaryEndingInZero) {
+	// An id below 256 ends the message with a zero byte.
+	const string raw {"\xFE\x02\x05\x00\x01\x01\x02\x00\x07\x00", 10};
+	Message r;
+	ASSERT_TRUE(Message::fromBinary(raw, r));
+	EXPECT_EQ(r.getType(), Message::Types::SetElement);
+	EXPECT_EQ(r.getId(0), 7);
+	// Without the last byte it is truncated.
+	EXPECT_FALSE(Message::fromBinary(raw.substr(0, raw.size() - 1), r));
+}
+
+TEST_F(MessageTest, BinaryMalformed) {
+	Message m(Message::Types::LoadProfile);
+	m.addData("profile");
+	string packed = m.toBinary();
+	Message r;
+
+	// Truncated.
+	EXPECT_FALSE(Message::fromBinary(packed.substr(0, packed.size() - 1), r));
+	// Trailing garbage.
+	EXPECT_FALSE(Message::fromBinary(packed + "x", r));
+	// One terminator is accepted, not two.
+	EXPECT_TRUE(Message::fromBinary(packed + '\0', r));
+	EXPECT_FALSE(Message::fromBinary(packed + string(2, '\0'), r));
+	// Wrong version.
+	string wrong(packed);
+	wrong[1] = 1;
+	EXPECT_FALSE(Message::fromBinary(wrong, r));
+	// Invalid type.
+	wrong = packed;
+	wrong[2] = 0;
+	EXPECT_FALSE(Message::fromBinary(wrong, r));
+}
+
+TEST_F(MessageTest, BatchOperations) {
+	Message set(Message::Types::SetElement);
+	set.addData("elem1");
+	set.addData("Red");
+	Message clear(Message::Types::ClearAllGroups);
+
+	Message batch(Message::Types::Batch);
+	batch.addOperation(set);
+	batch.addOperation(clear);
+	EXPECT_THROW(batch.addOperation(Message(Message::Types::LoadProfile)), Error);
+	EXPECT_EQ(Message::str2type("Batch"), Message::Types::Batch);
+
+	// Survives both protocols.
+	Message binary;
+	ASSERT_TRUE(Message::fromBinary(batch.toBinary(), binary));
+
+	auto operations = binary.getOperations();
+	ASSERT_EQ(operations.size(), 2);
+	EXPECT_EQ(operations[0].getType(), Message::Types::SetElement);
+	EXPECT_EQ(operations[0].getData(), set.getData());
+	EXPECT_EQ(operations[1].getType(), Message::Types::ClearAllGroups);
+	EXPECT_TRUE(operations[1].getData().empty());
+
+	// Non batchable operations come back as invalid.
+	Message wrong(Message::Types::Batch);
+	wrong.addData(std::to_string(static_cast<int>(Message::Types::LoadProfile)) + string(1, GROUP_SEPARATOR) + "profile");
+	EXPECT_EQ(wrong.getOperations()[0].getType(), Message::Types::Invalid);
+}
+
+TEST_F(MessageTest, BinaryLimits) {
+	Message batch(Message::Types::Batch);
+	for (size_t c = 0; c < BINARY_MAX_FIELDS; ++c)
+		batch.addOperation(Message(Message::Types::ClearAllGroups));
+	Message r;
+	ASSERT_TRUE(Message::fromBinary(batch.toBinary(), r));
+	EXPECT_EQ(r.getOperations().size(), BINARY_MAX_FIELDS);
+	batch.addOperation(Message(Message::Types::ClearAllGroups));
+	EXPECT_THROW(batch.toBinary(), Error);
+
+	Message text(Message::Types::LoadProfile);
+	text.addData(string(BINARY_MAX_LENGTH, 'a'));
+	ASSERT_TRUE(Message::fromBinary(text.toBinary(), r));
+	EXPECT_EQ(r.getData()[0].size(), BINARY_MAX_LENGTH);
+	text.setData({string(BINARY_MAX_LENGTH + 1, 'a')});
+	EXPECT_THROW(text.toBinary(), Error);
+}
+
+TEST_F(MessageTest, BatchOperationsWithIds) {
+	Message set(Message::Types::SetElement);
+	set.addId(3);
+	set.addData("Red");
+	set.addId(1);
+	Message clear(Message::Types::ClearGroup);
+	clear.addId(258);
+
+	Message batch(Message::Types::Batch);
+	batch.addOperation(set);
+	batch.addOperation(clear);
+
+	Message binary;
+	ASSERT_TRUE(Message::fromBinary(batch.toBinary(), binary));
+	auto operations = binary.getOperations();
+	ASSERT_EQ(operations.size(), 2);
+	EXPECT_EQ(operations[0].getType(), Message::Types::SetElement);
+	EXPECT_EQ(operations[0].getId(0), 3);
+	EXPECT_EQ(operations[0].getId(1), NO_ID);
+	EXPECT_EQ(operations[0].getData()[1], "Red");
+	EXPECT_EQ(operations[0].getId(2), 1);
+	EXPECT_EQ(operations[1].getType(), Message::Types::ClearGroup);
+	EXPECT_EQ(operations[1].getId(0), 258);
+
+	// Nested operations must be valid and batchable.
+	Message nested(Message::Types::Batch);
+	nested.addOperation(clear);
+	string packed(nested.toBinary());
+	string wrong(packed);
+	wrong[BINARY_HEADER + BINARY_FIELD + 2] = static_cast<char>(Message::Types::LoadProfile);
+	EXPECT_FALSE(Message::fromBinary(wrong, binary));
+	EXPECT_FALSE(Message::fromBinary(packed.substr(0, packed.size() - 1), binary));
+
+	// Operations only go one level deep, and only inside a batch.
+	auto operationField = [](const string& operation) {
+		return string(1, static_cast<char>(Message::Fields::Operation)) +
+			static_cast<char>(operation.size() & 0xFF) + static_cast<char>(operation.size() >> 8) + operation;
+	};
+	auto header = [](Message::Types type, uint8_t fields) {
+		return string{static_cast<char>(BINARY_MAGIC), BINARY_VERSION, static_cast<char>(type), 0, static_cast<char>(fields)};
+	};
+	string inner(header(Message::Types::Batch, 1) + operationField(clear.toBinary()));
+	EXPECT_FALSE(Message::fromBinary(header(Message::Types::Batch, 1) + operationField(inner), binary));
+	EXPECT_FALSE(Message::fromBinary(header(Message::Types::SetElement, 1) + operationField(clear.toBinary()), binary));
+	EXPECT_TRUE(Message::fromBinary(header(Message::Types::Batch, 1) + operationField(clear.toBinary()), binary));
+	// A nested operation cannot carry the terminator.
+	EXPECT_FALSE(Message::fromBinary(header(Message::Types::Batch, 1) + operationField(clear.toBinary() + '\0'), binary));
+}
+
 int main(int argc, char **argv) {
 	::testing::InitGoogleTest(&argc, argv);
 	return RUN_ALL_TESTS();
@@ -171,6 +171,52 @@ TEST_F(MessagesTest, MultipleMessages) {
 	EXPECT_FALSE(server.read());
 }
 
+TEST_F(MessagesTest, ReadBinaryMessage) {
+	Messages server(testPort);
+	Socks client(LOCALHOST, testPort, false);
+
+	Message msg(Message::Types::SetGroup);
+	msg.addId(0);
+	msg.addData("Red");
+	client.send(msg.toBinary());
+
+	sleep_for(std::chrono::milliseconds(100));
+
+	EXPECT_TRUE(server.read());
+	Message received = server.getMessage();
+	EXPECT_EQ(received.getType(), Message::Types::SetGroup);
+	ASSERT_EQ(received.getData().size(), 2);
+	EXPECT_EQ(received.getId(0), 0);
+	EXPECT_EQ(received.getData()[1], "Red");
+	EXPECT_FALSE(server.read());
+}
+
+TEST_F(MessagesTest, DrainsPendingMessages) {
+	Messages server(testPort);
+	Socks client(LOCALHOST, testPort, false);
+
+	// More than a single batch read.
+	const int total = RECEIVE_BATCH * 2 + 5;
+	for (int c = 0; c < total; ++c) {
+		Message msg(Message::Types::SetElement);
+		msg.addData("Element" + to_string(c));
+		client.send(msg.toString());
+	}
+
+	sleep_for(std::chrono::milliseconds(100));
+
+	// A single read queues them all, in order.
+	EXPECT_TRUE(server.read());
+	for (int c = 0; c < total; ++c) {
+		ASSERT_TRUE(server.hasMessages());
+		Message received = server.getMessage();
+		ASSERT_EQ(received.getData().size(), 1);
+		EXPECT_EQ(received.getData()[0], "Element" + to_string(c));
+	}
+	EXPECT_FALSE(server.hasMessages());
+	EXPECT_FALSE(server.read());
+}
+
 int main(int argc, char **argv) {
 	::testing::InitGoogleTest(&argc, argv);
 	return RUN_ALL_TESTS();
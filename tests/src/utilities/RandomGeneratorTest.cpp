@@ -0,0 +1,78 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      RandomGeneratorTest.cpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+#include "utilities/RandomGenerator.hpp"
+
+using namespace LEDSpicer::Utilities;
+
+TEST(RandomGeneratorTest, SameSeedSameNumbers) {
+	RandomGenerator a(42), b(42), c(43);
+	bool different = false;
+	for (uint16_t n = 0; n < 1000; ++n) {
+		uint32_t value = a.next();
+		EXPECT_EQ(value, b.next());
+		different |= value != c.next();
+	}
+	EXPECT_TRUE(different);
+
+	// Reseeding restarts the sequence.
+	RandomGenerator d(7);
+	uint32_t first = d.next();
+	d.next();
+	d.seed(7);
+	EXPECT_EQ(d.next(), first);
+}
+
+TEST(RandomGeneratorTest, Below) {
+	RandomGenerator generator(1);
+	array<uint32_t, 6> hits {};
+	for (uint32_t n = 0; n < 60000; ++n) {
+		uint32_t value = generator.below(hits.size());
+		ASSERT_LT(value, hits.size());
+		++hits[value];
+	}
+	// Every value is reachable and close to a sixth.
+	for (uint32_t h : hits) {
+		EXPECT_GT(h, 9000u);
+		EXPECT_LT(h, 11000u);
+	}
+	EXPECT_EQ(generator.below(1), 0u);
+	EXPECT_EQ(generator.below(0), 0u);
+}
+
+TEST(RandomGeneratorTest, GlobalSeed) {
+	RandomGenerator::setSeed(99);
+	EXPECT_EQ(RandomGenerator::getSeed(), 99u);
+	uint32_t first = RandomGenerator::shared().next();
+	RandomGenerator::shared().next();
+	RandomGenerator::setSeed(99);
+	EXPECT_EQ(RandomGenerator::shared().next(), first);
+
+	// Every stream gets its own numbers.
+	RandomGenerator
+		stream1(RandomGenerator::getSeed(1)),
+		stream2(RandomGenerator::getSeed(2));
+	EXPECT_NE(RandomGenerator::getSeed(1), RandomGenerator::getSeed(2));
+	EXPECT_NE(stream1.next(), stream2.next());
+}
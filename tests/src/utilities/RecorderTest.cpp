@@ -0,0 +1,96 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      RecorderTest.cpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+#include "utilities/Recorder.hpp"
+#include "utilities/RandomGenerator.hpp"
+
+using namespace LEDSpicer::Utilities;
+
+static const string recording("/tmp/ledspicer-recorder-test.rec");
+
+TEST(RecorderTest, RecordAndReplay) {
+	RandomGenerator::setSeed(1234);
+	Recorder::startRecording(recording);
+	uint32_t first = RandomGenerator::shared().next();
+	EXPECT_TRUE(Recorder::isRecording());
+	Recorder::record(Recorder::Sources::Message, string("message"));
+	Recorder::output(1);
+	EXPECT_TRUE(Recorder::newFrame());
+	uint16_t peaks[] = {10, 20};
+	Recorder::record(Recorder::Sources::Audio, peaks, sizeof(peaks));
+	Recorder::record(Recorder::Sources::Mame, "", 0);
+	Recorder::output(2);
+	EXPECT_TRUE(Recorder::newFrame());
+	Recorder::output(3);
+	EXPECT_EQ(Recorder::getFrames(), 3u);
+	Recorder::stop();
+	EXPECT_FALSE(Recorder::isRecording());
+
+	RandomGenerator::setSeed(1);
+	Recorder::startReplay(recording);
+	EXPECT_TRUE(Recorder::isReplaying());
+	// Same seed.
+	EXPECT_EQ(RandomGenerator::getSeed(), 1234u);
+	EXPECT_EQ(RandomGenerator::shared().next(), first);
+
+	string data;
+	EXPECT_TRUE(Recorder::next(Recorder::Sources::Message, data));
+	EXPECT_EQ(data, "message");
+	EXPECT_FALSE(Recorder::next(Recorder::Sources::Message, data));
+	EXPECT_FALSE(Recorder::next(Recorder::Sources::Audio, data));
+	Recorder::output(1);
+
+	EXPECT_TRUE(Recorder::newFrame());
+	ASSERT_TRUE(Recorder::next(Recorder::Sources::Audio, data));
+	EXPECT_EQ(data, string(reinterpret_cast<const char*>(peaks), sizeof(peaks)));
+	EXPECT_TRUE(Recorder::next(Recorder::Sources::Mame, data));
+	EXPECT_TRUE(data.empty());
+	Recorder::output(5);
+
+	EXPECT_TRUE(Recorder::newFrame());
+	Recorder::output(3);
+	EXPECT_FALSE(Recorder::newFrame());
+	EXPECT_EQ(Recorder::getFrames(), 3u);
+	EXPECT_EQ(Recorder::getMismatches(), 1u);
+	Recorder::stop();
+	EXPECT_FALSE(Recorder::isReplaying());
+	::unlink(recording.c_str());
+}
+
+TEST(RecorderTest, RecordingIsIgnoredWhenOff) {
+	string data;
+	Recorder::record(Recorder::Sources::Input, string("event"));
+	EXPECT_FALSE(Recorder::next(Recorder::Sources::Input, data));
+	EXPECT_TRUE(Recorder::newFrame());
+}
+
+TEST(RecorderTest, InvalidRecording) {
+	{
+		std::ofstream file(recording);
+		file << "Not a recording";
+	}
+	EXPECT_THROW(Recorder::startReplay(recording), Error);
+	EXPECT_FALSE(Recorder::isReplaying());
+	::unlink(recording.c_str());
+}
@@ -0,0 +1,96 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      SPSCQueueTest.cpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include "utilities/SPSCQueue.hpp"
+
+using namespace LEDSpicer::Utilities;
+
+TEST(SPSCQueueTest, PushPopInOrder) {
+	SPSCQueue<int, 4> queue;
+	int value = 0;
+	EXPECT_TRUE(queue.empty());
+	EXPECT_FALSE(queue.pop(value));
+	for (int c = 1; c <= 4; ++c)
+		EXPECT_TRUE(queue.push(c));
+	EXPECT_EQ(queue.size(), 4u);
+	// Full.
+	EXPECT_FALSE(queue.push(5));
+	for (int c = 1; c <= 4; ++c) {
+		EXPECT_TRUE(queue.pop(value));
+		EXPECT_EQ(value, c);
+	}
+	EXPECT_TRUE(queue.empty());
+}
+
+TEST(SPSCQueueTest, WrapsAround) {
+	SPSCQueue<int, 4> queue;
+	int value = 0;
+	for (int c = 0; c < 10; ++c) {
+		EXPECT_TRUE(queue.push(c));
+		EXPECT_TRUE(queue.push(c + 100));
+		EXPECT_TRUE(queue.pop(value));
+		EXPECT_EQ(value, c);
+		EXPECT_TRUE(queue.pop(value));
+		EXPECT_EQ(value, c + 100);
+	}
+	queue.push(1);
+	queue.clear();
+	EXPECT_TRUE(queue.empty());
+}
+
+TEST(SPSCQueueTest, Bulk) {
+	SPSCQueue<int, 8> queue;
+	int in[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9}, out[10] = {};
+	EXPECT_EQ(queue.push(in, 5), 5u);
+	EXPECT_EQ(queue.pop(out, 3), 3u);
+	// Only what fits, across the end of the ring.
+	EXPECT_EQ(queue.push(in + 5, 5), 5u);
+	EXPECT_EQ(queue.push(in, 10), 1u);
+	EXPECT_EQ(queue.pop(out + 3, 7), 7u);
+	for (int c = 0; c < 10; ++c)
+		EXPECT_EQ(out[c], c);
+	EXPECT_EQ(queue.pop(out, 1), 1u);
+	EXPECT_EQ(out[0], 0);
+	EXPECT_TRUE(queue.empty());
+}
+
+TEST(SPSCQueueTest, ProducerThread) {
+	SPSCQueue<uint32_t, 64> queue;
+	const uint32_t total = 100000;
+	std::thread producer([&] {
+		for (uint32_t c = 0; c < total; ++c)
+			while (not queue.push(c))
+				std::this_thread::yield();
+	});
+	uint32_t expected = 0, value;
+	while (expected < total) {
+		if (not queue.pop(value)) {
+			std::this_thread::yield();
+			continue;
+		}
+		ASSERT_EQ(value, expected);
+		++expected;
+	}
+	producer.join();
+	EXPECT_TRUE(queue.empty());
+}
@@ -132,6 +132,209 @@ TEST(SocksTest, DestructorDisconnects) {
 	s2.disconnect();
 }
 
+TEST(SocksTest, UnixDatagramTransmission) {
+	const string path = "/tmp/ledspicer_socks_test_dgram";
+	string received;
+
+	Socks server;
+	server.setAllowedUsers({getuid()});
+	ASSERT_NO_THROW(server.prepareUnix(path, true, SOCK_DGRAM));
+
+	Socks client;
+	ASSERT_NO_THROW(client.prepareUnix(path, false, SOCK_DGRAM));
+	EXPECT_TRUE(client.send("Unix message"));
+
+	sleep_for(std::chrono::milliseconds(100));
+
+	EXPECT_TRUE(server.receive(received));
+	EXPECT_EQ(received, "Unix message");
+	EXPECT_FALSE(server.receive(received));
+
+	// Socket file is removed on disconnect.
+	server.disconnect();
+	EXPECT_NE(access(path.c_str(), F_OK), 0);
+}
+
+TEST(SocksTest, UnixSeqPacketConnections) {
+	const string path = "/tmp/ledspicer_socks_test_seqpacket";
+	string received;
+
+	Socks server;
+	ASSERT_NO_THROW(server.prepareUnix(path, true, SOCK_SEQPACKET));
+
+	// Connections stay open across several messages.
+	Socks client1, client2;
+	ASSERT_NO_THROW(client1.prepareUnix(path, false, SOCK_SEQPACKET));
+	ASSERT_NO_THROW(client2.prepareUnix(path, false, SOCK_SEQPACKET));
+	EXPECT_TRUE(client1.send("First"));
+	EXPECT_TRUE(client1.send("Second"));
+	EXPECT_TRUE(client2.send("Third"));
+
+	sleep_for(std::chrono::milliseconds(100));
+
+	// The clients take turns.
+	vector<string> messages;
+	while (server.receive(received))
+		messages.push_back(received);
+	ASSERT_EQ(messages.size(), 3u);
+	EXPECT_EQ(messages[0], "First");
+	EXPECT_EQ(messages[1], "Third");
+	EXPECT_EQ(messages[2], "Second");
+
+	// A closed client does not stop the others.
+	client1.disconnect();
+	EXPECT_TRUE(client2.send("Fourth"));
+	sleep_for(std::chrono::milliseconds(100));
+	EXPECT_TRUE(server.receive(received));
+	EXPECT_EQ(received, "Fourth");
+}
+
+TEST(SocksTest, UnixSeqPacketClientsLimit) {
+	const string path = "/tmp/ledspicer_socks_test_limit";
+	string received;
+
+	Socks server;
+	ASSERT_NO_THROW(server.prepareUnix(path, true, SOCK_SEQPACKET));
+
+	vector<std::unique_ptr<Socks>> clients;
+	for (size_t c = 0; c <= SOCKET_CLIENTS; ++c) {
+		clients.push_back(std::make_unique<Socks>());
+		ASSERT_NO_THROW(clients.back()->prepareUnix(path, false, SOCK_SEQPACKET));
+		clients.back()->send(to_string(c));
+	}
+	sleep_for(std::chrono::milliseconds(100));
+
+	// The connection over the limit is closed.
+	size_t count = 0;
+	while (server.receive(received)) {
+		EXPECT_NE(received, to_string(SOCKET_CLIENTS));
+		++count;
+	}
+	EXPECT_EQ(count, SOCKET_CLIENTS);
+}
+
+TEST(SocksTest, UnixRejectsUsers) {
+	const string path = "/tmp/ledspicer_socks_test_rejected";
+	string received;
+
+	Socks server;
+	server.setAllowedUsers({getuid() + 1});
+	ASSERT_NO_THROW(server.prepareUnix(path, true, SOCK_SEQPACKET));
+
+	Socks client;
+	ASSERT_NO_THROW(client.prepareUnix(path, false, SOCK_SEQPACKET));
+	client.send("Not allowed");
+	sleep_for(std::chrono::milliseconds(100));
+	EXPECT_FALSE(server.receive(received));
+}
+
+TEST(SocksTest, UnixSkipsRejectedDatagrams) {
+	// Only root can send the credentials of another user.
+	if (getuid())
+		GTEST_SKIP();
+	const string path = "/tmp/ledspicer_socks_test_skipped";
+
+	Socks server;
+	server.setAllowedUsers({getuid()});
+	ASSERT_NO_THROW(server.prepareUnix(path, true, SOCK_DGRAM));
+
+	int fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+	ASSERT_GE(fd, 0);
+	sockaddr_un address {};
+	address.sun_family = AF_UNIX;
+	path.copy(address.sun_path, sizeof(address.sun_path) - 1);
+	auto sendAs = [&](uid_t uid, const string& text) {
+		ucred credentials {getpid(), uid, getgid()};
+		char control[CMSG_SPACE(sizeof(ucred))] {};
+		iovec part {const_cast<char*>(text.data()), text.size()};
+		msghdr header {};
+		header.msg_name       = &address;
+		header.msg_namelen    = sizeof(address);
+		header.msg_iov        = &part;
+		header.msg_iovlen     = 1;
+		header.msg_control    = control;
+		header.msg_controllen = sizeof(control);
+		cmsghdr* message = CMSG_FIRSTHDR(&header);
+		message->cmsg_level = SOL_SOCKET;
+		message->cmsg_type  = SCM_CREDENTIALS;
+		message->cmsg_len   = CMSG_LEN(sizeof(ucred));
+		memcpy(CMSG_DATA(message), &credentials, sizeof(ucred));
+		return sendmsg(fd, &header, 0) == static_cast<ssize_t>(text.size());
+	};
+	ASSERT_TRUE(sendAs(getuid() + 1, "Rejected"));
+	ASSERT_TRUE(sendAs(getuid(), "Allowed"));
+	::close(fd);
+	sleep_for(std::chrono::milliseconds(100));
+
+	// The rejected message does not end the drain.
+	vector<string> buffers;
+	ASSERT_EQ(server.receiveBatch(buffers, 4), 1u);
+	EXPECT_EQ(buffers[0], "Allowed");
+}
+
+TEST(SocksTest, UnixInvalidType) {
+	EXPECT_EQ(Socks::str2type("Datagram"), SOCK_DGRAM);
+	EXPECT_EQ(Socks::str2type("SeqPacket"), SOCK_SEQPACKET);
+	EXPECT_THROW(Socks::str2type("Stream"), Error);
+}
+
+TEST(SocksTest, ReceiveIntoBuffer) {
+	const string port = "54324";
+	char buffer[64];
+
+	Socks server;
+	ASSERT_NO_THROW(server.prepare("127.0.0.1", port, true));
+	Socks client;
+	ASSERT_NO_THROW(client.prepare("127.0.0.1", port, false));
+
+	EXPECT_EQ(server.receive(buffer, sizeof(buffer)), 0);
+	ASSERT_TRUE(client.send("lamp0 = 1"));
+	sleep_for(std::chrono::milliseconds(100));
+	// The message and the terminator sent by send().
+	ssize_t r = server.receive(buffer, sizeof(buffer));
+	ASSERT_GT(r, 0);
+	EXPECT_EQ(string(buffer, 9), "lamp0 = 1");
+
+	server.disconnect();
+	EXPECT_EQ(server.receive(buffer, sizeof(buffer)), -1);
+}
+
+TEST(SocksTest, BinaryWithoutTerminator) {
+	const string port = "54325";
+	// SetElement with one id field, the id high byte is the last byte and it is zero.
+	const string raw {"\xFE\x02\x05\x00\x01\x01\x02\x00\x07\x00", 10};
+	string received;
+
+	Socks server;
+	ASSERT_NO_THROW(server.prepare("127.0.0.1", port, true));
+
+	// A frontend that sends the frame as is, without the terminator added by send().
+	int fd = socket(AF_INET, SOCK_DGRAM, 0);
+	ASSERT_GE(fd, 0);
+	sockaddr_in address {};
+	address.sin_family      = AF_INET;
+	address.sin_port        = htons(std::stoi(port));
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	for (uint8_t c = 0; c < 2; ++c)
+		ASSERT_EQ(sendto(fd, raw.data(), raw.size(), 0, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 10);
+	close(fd);
+	sleep_for(std::chrono::milliseconds(100));
+
+	EXPECT_TRUE(server.receive(received));
+	EXPECT_EQ(received, raw);
+	vector<string> batch;
+	ASSERT_EQ(server.receiveBatch(batch, 4), 1u);
+	EXPECT_EQ(batch[0], raw);
+
+	// Text keeps losing its terminator.
+	Socks client;
+	ASSERT_NO_THROW(client.prepare("127.0.0.1", port, false));
+	EXPECT_TRUE(client.send("text"));
+	sleep_for(std::chrono::milliseconds(100));
+	EXPECT_TRUE(server.receive(received));
+	EXPECT_EQ(received, "text");
+}
+
 // Main function for running tests
 int main(int argc, char **argv) {
 	::testing::InitGoogleTest(&argc, argv);
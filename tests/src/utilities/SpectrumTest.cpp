@@ -0,0 +1,57 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 4; tab-width: 4 -*-  */
+/**
+ * @file      SpectrumTest.cpp
+ * @since     Oct 19, 2026
+ * @author    Patricio A. Rossi (MeduZa)
+ *
+ * @copyright Copyright © 2026 Patricio A. Rossi (MeduZa)
+ *
+ * @copyright LEDSpicer is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * @copyright LEDSpicer is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * @copyright You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include "utilities/Spectrum.hpp"
+
+using namespace LEDSpicer::Utilities;
+
+TEST(SpectrumTest, SineLightsItsBand) {
+	Spectrum spectrum(1024, 48000);
+	vector<int16_t> samples(2 * 4096);
+	for (size_t s = 0; s < samples.size() / 2; ++s)
+		samples[s * 2] = samples[s * 2 + 1] = 16000 * std::sin(2 * M_PI * 1000 * s / 48000);
+	spectrum.feed(samples.data(), samples.size() / 2, 2);
+
+	// Wait for the thread.
+	vector<float> bands;
+	for (uint8_t c = 0; c < 100; ++c) {
+		bands = spectrum.getBands(10);
+		if (std::any_of(bands.begin(), bands.end(), [](float b) { return b > 0; }))
+			break;
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	ASSERT_EQ(bands.size(), 10u);
+	// 50Hz to 16kHz in 10 bands, 1kHz lands on the 6th.
+	auto loudest = std::max_element(bands.begin(), bands.end()) - bands.begin();
+	EXPECT_EQ(loudest, 5);
+	EXPECT_GT(bands[5], 80);
+}
+
+TEST(SpectrumTest, BandsCached) {
+	Spectrum spectrum(512, 48000);
+	const vector<float>& first = spectrum.getBands(8);
+	EXPECT_EQ(&first, &spectrum.getBands(8));
+	EXPECT_EQ(spectrum.getBands(4).size(), 4u);
+}
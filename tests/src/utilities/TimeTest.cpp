@@ -76,6 +76,20 @@ TEST_F(TimeTest, ResetTimer) {
 	EXPECT_TRUE(timeObj.isTime());
 }
 
+TEST_F(TimeTest, VirtualClock) {
+	system_clock::time_point start(system_clock::now() - std::chrono::hours(1));
+	Time::setVirtualTime(start);
+	Time::setFrameTime();
+	Time timeObj(1);
+	// The system clock is an hour ahead.
+	EXPECT_FALSE(timeObj.isTime());
+	Time::setVirtualTime(start + std::chrono::milliseconds(1001));
+	EXPECT_TRUE(timeObj.isTime());
+	Time::setVirtualTime({});
+	Time::setFrameTime();
+	EXPECT_FALSE(Time(1).isTime());
+}
+
 // Main function for running tests
 int main(int argc, char **argv) {
 	::testing::InitGoogleTest(&argc, argv);